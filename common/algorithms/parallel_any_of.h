@@ -16,6 +16,8 @@ namespace embree
     ret = false;
     
 #if defined(TASKING_TBB)
+    if (!ExternalTaskScheduler::enabled())
+    {
 #if TBB_INTERFACE_VERSION >= 12002
     tbb::task_group_context context;
     tbb::parallel_for(tbb::blocked_range<size_t>{first, last}, [&ret,pred,&context](const tbb::blocked_range<size_t>& r) {
@@ -38,7 +40,10 @@ namespace embree
         }
       });
 #endif
-#else
+      return ret;
+    }
+#endif
+
     ret = parallel_reduce (first, last, false, [pred](const range<size_t>& r)->bool {
         bool localret = false;
         for (auto i=r.begin(); i<r.end(); ++i) {
@@ -48,7 +53,6 @@ namespace embree
       },
       std::bit_or<bool>()
       );
-#endif
     
     return ret;
   }
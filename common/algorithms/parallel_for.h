@@ -14,6 +14,13 @@ namespace embree
   template<typename Index, typename Func>
     __forceinline void parallel_for( const Index N, const Func& func)
   {
+    if (ExternalTaskScheduler::enabled()) {
+      ExternalTaskScheduler::parallel_for(size_t(0),size_t(N),size_t(1),[&] (size_t i0, size_t i1) {
+          for (size_t i=i0; i<i1; i++) func(Index(i));
+        });
+      return;
+    }
+    
 #if defined(TASKING_INTERNAL) && !defined(TASKING_TBB)
     if (N) {
       TaskScheduler::TaskGroupContext context;
@@ -56,6 +63,13 @@ namespace embree
     __forceinline void parallel_for( const Index first, const Index last, const Index minStepSize, const Func& func)
   {
     assert(first <= last);
+    if (ExternalTaskScheduler::enabled()) {
+      ExternalTaskScheduler::parallel_for(size_t(first),size_t(last),size_t(minStepSize),[&] (size_t i0, size_t i1) {
+          func(range<Index>(Index(i0),Index(i1)));
+        });
+      return;
+    }
+    
 #if defined(TASKING_INTERNAL) && !defined(TASKING_TBB)
     TaskScheduler::TaskGroupContext context;
     TaskScheduler::spawn(first,last,minStepSize,func,&context);
@@ -103,6 +117,9 @@ namespace embree
   template<typename Index, typename Func>
     __forceinline void parallel_for_static( const Index N, const Func& func)
   {
+    if (ExternalTaskScheduler::enabled())
+      return parallel_for(N,func);
+    
     #if TBB_INTERFACE_VERSION >= 12002
       tbb::task_group_context context;
       tbb::parallel_for(Index(0),N,Index(1),[&](Index i) {
@@ -124,6 +141,9 @@ namespace embree
   template<typename Index, typename Func>
     __forceinline void parallel_for_affinity( const Index N, const Func& func, tbb::affinity_partitioner& ap)
   {
+    if (ExternalTaskScheduler::enabled())
+      return parallel_for(N,func);
+    
     #if TBB_INTERFACE_VERSION >= 12002
       tbb::task_group_context context;
       tbb::parallel_for(Index(0),N,Index(1),[&](Index i) {
@@ -43,16 +43,20 @@ namespace embree
   template<typename Index, typename Value, typename Func, typename Reduction>
     __forceinline Value parallel_reduce( const Index first, const Index last, const Index minStepSize, const Value& identity, const Func& func, const Reduction& reduction )
   {
-#if defined(TASKING_INTERNAL) && !defined(TASKING_TBB)
-
-    /* fast path for small number of iterations */
-    Index taskCount = (last-first+minStepSize-1)/minStepSize;
-    if (likely(taskCount == 1)) {
-      return func(range<Index>(first,last));
+    /* the internal tasking system and external tasking functions reduce over a fixed number of tasks */
+#if !defined(TASKING_INTERNAL) || defined(TASKING_TBB)
+    if (ExternalTaskScheduler::enabled())
+#endif
+    {
+      /* fast path for small number of iterations */
+      Index taskCount = (last-first+minStepSize-1)/minStepSize;
+      if (likely(taskCount == 1)) {
+        return func(range<Index>(first,last));
+      }
+      return parallel_reduce_internal(taskCount,first,last,minStepSize,identity,func,reduction);
     }
-    return parallel_reduce_internal(taskCount,first,last,minStepSize,identity,func,reduction);
 
-#elif defined(TASKING_TBB)
+#if defined(TASKING_TBB)
   #if TBB_INTERFACE_VERSION >= 12002
     tbb::task_group_context context;
     const Value v = tbb::parallel_reduce(tbb::blocked_range<Index>(first,last,minStepSize),identity,
@@ -69,7 +73,7 @@ namespace embree
       throw std::runtime_error("task cancelled");
     return v;
   #endif
-#else // TASKING_PPL
+#elif defined(TASKING_PPL)
     struct AlignedValue
     {
       char storage[__alignof(Value)+sizeof(Value)];
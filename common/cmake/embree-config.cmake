@@ -33,6 +33,7 @@ SET(EMBREE_TUTORIALS @EMBREE_TUTORIALS@)
 
 SET(EMBREE_RAY_MASK @EMBREE_RAY_MASK@)
 SET(EMBREE_STAT_COUNTERS @EMBREE_STAT_COUNTERS@)
+SET(EMBREE_BVH_NODE_PROFILE @EMBREE_BVH_NODE_PROFILE@)
 SET(EMBREE_BACKFACE_CULLING @EMBREE_BACKFACE_CULLING@)
 SET(EMBREE_FILTER_FUNCTION @EMBREE_FILTER_FUNCTION@)
 SET(EMBREE_IGNORE_INVALID_RAYS @EMBREE_IGNORE_INVALID_RAYS@)
@@ -45,6 +45,13 @@ namespace embree
         return range (max(_begin,r._begin),min(_end,r._end));
       }
 
+      /*! returns the smallest range containing both ranges, empty ranges are ignored */
+      __forceinline range merge(const range& r) const {
+        if (empty()) return r;
+        if (r.empty()) return *this;
+        return range (min(_begin,r._begin),max(_end,r._end));
+      }
+
       __forceinline Ty size() const {
         return _end - _begin;
       }
@@ -160,7 +160,27 @@ namespace embree
     static __forceinline vfloat4 load(const unsigned short* ptr) {
       return _mm_mul_ps(vfloat4(vint4::load(ptr)),vfloat4(1.0f/65535.0f));
     }
-    
+
+    /* loads 4 half precision floats */
+#if defined(__F16C__)
+    static __forceinline vfloat4 load_hf16(const void* ptr) {
+      return _mm_cvtph_ps(_mm_loadl_epi64((__m128i*)ptr));
+    }
+#else
+    static __forceinline vfloat4 load_hf16(const void* ptr)
+    {
+      const __m128i h    = _mm_unpacklo_epi16(_mm_loadl_epi64((__m128i*)ptr),_mm_setzero_si128());
+      const __m128i em   = _mm_slli_epi32(_mm_and_si128(h,_mm_set1_epi32(0x7fff)),13);
+      const __m128i sign = _mm_slli_epi32(_mm_and_si128(h,_mm_set1_epi32(0x8000)),16);
+      /* rebias the exponent by scaling with 2^112, which also handles denormals */
+      const __m128 f = _mm_mul_ps(_mm_castsi128_ps(em),_mm_castsi128_ps(_mm_set1_epi32(0x77800000)));
+      /* infinities and NaNs keep the maximal exponent */
+      const __m128 infnan = _mm_castsi128_ps(_mm_cmpgt_epi32(em,_mm_set1_epi32(0x0f7fffff)));
+      const __m128 r = _mm_or_ps(f,_mm_and_ps(infnan,_mm_castsi128_ps(_mm_set1_epi32(0x7f800000))));
+      return _mm_or_ps(r,_mm_castsi128_ps(sign));
+    }
+#endif
+
     static __forceinline void store_nt(void* ptr, const vfloat4& v)
     {
 #if defined (__SSE4_1__)
@@ -0,0 +1,16 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "taskschedulerexternal.h"
+
+namespace embree
+{
+  ExternalTaskScheduler::Functions ExternalTaskScheduler::functions;
+  __thread size_t ExternalTaskScheduler::sequential = 0;
+
+  void ExternalTaskScheduler::set(const Functions* f)
+  {
+    if (f && f->parallelFor) functions = *f;
+    else                     functions = Functions();
+  }
+}
@@ -0,0 +1,109 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "../sys/platform.h"
+
+#include <atomic>
+#include <exception>
+
+namespace embree
+{
+  /*! Forwards all parallel work to tasking functions registered by
+   *  the application. While registered, parallel_for and all algorithms
+   *  built on top of it execute as jobs of the application's scheduler
+   *  instead of the built-in tasking system. Inside a SequentialScope
+   *  all parallel work of the current thread executes sequentially. */
+  struct ExternalTaskScheduler
+  {
+    typedef void (*TaskFunction)(void* taskPtr, size_t taskBegin, size_t taskEnd);
+    typedef void (*ParallelForFunction)(void* userPtr, size_t begin, size_t end, size_t blockSize, TaskFunction func, void* taskPtr);
+    typedef unsigned int (*ThreadFunction)(void* userPtr);
+
+    struct Functions
+    {
+      Functions ()
+        : parallelFor(nullptr), threadIndex(nullptr), threadCount(nullptr), userPtr(nullptr) {}
+
+      ParallelForFunction parallelFor;
+      ThreadFunction threadIndex;
+      ThreadFunction threadCount;
+      void* userPtr;
+    };
+
+    /*! executes all parallel work of the current thread sequentially
+     *  while in scope, used for builds too small to amortize the
+     *  tasking overhead */
+    struct SequentialScope
+    {
+      __forceinline SequentialScope () { sequential++; }
+      __forceinline ~SequentialScope () { sequential--; }
+    };
+
+    /*! registers the tasking functions, passing nullptr disables external tasking again */
+    static void set(const Functions* functions);
+
+    /*! returns true if external tasking functions are registered or the current thread executes sequentially */
+    static __forceinline bool enabled() {
+      return functions.parallelFor != nullptr || sequential != 0;
+    }
+
+    /* returns the index (0..threadCount-1) of the current thread */
+    static __forceinline size_t threadIndex() {
+      if (sequential) return 0;
+      return functions.threadIndex(functions.userPtr);
+    }
+
+    /* returns the total number of threads */
+    static __forceinline size_t threadCount() {
+      if (sequential) return 1;
+      const size_t N = functions.threadCount(functions.userPtr);
+      return N ? N : 1;
+    }
+
+    /*! executes func for subranges of [begin,end) using the application's
+     *  scheduler, the first exception thrown by a task cancels all tasks
+     *  not yet started and is rethrown afterwards */
+    template<typename Func>
+    static void parallel_for(size_t begin, size_t end, size_t blockSize, const Func& func)
+    {
+      if (begin >= end) return;
+      if (sequential) return func(begin,end);
+
+      Task<Func> task(func);
+      functions.parallelFor(functions.userPtr,begin,end,blockSize ? blockSize : 1,&Task<Func>::run,&task);
+      if (task.exception != nullptr)
+        std::rethrow_exception(task.exception);
+    }
+
+  private:
+
+    template<typename Func>
+    struct Task
+    {
+      Task (const Func& func)
+        : func(func), cancelled(false) {}
+
+      static void run(void* taskPtr, size_t taskBegin, size_t taskEnd)
+      {
+        Task* task = (Task*) taskPtr;
+        if (task->cancelled.load()) return;
+        try {
+          task->func(taskBegin,taskEnd);
+        }
+        catch (...) {
+          if (!task->cancelled.exchange(true))
+            task->exception = std::current_exception();
+        }
+      }
+
+      const Func& func;
+      std::atomic<bool> cancelled;
+      std::exception_ptr exception;
+    };
+
+    static Functions functions;
+    static __thread size_t sequential;
+  };
+}
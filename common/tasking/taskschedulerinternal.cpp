@@ -5,6 +5,7 @@
 #include "../math/emath.h"
 #include "../sys/sysinfo.h"
 #include <algorithm>
+#include <iostream>
 
 namespace embree
 {
@@ -16,30 +17,121 @@ namespace embree
   std::vector<Ref<TaskScheduler>> g_instance_vector;
   __thread TaskScheduler::Thread* TaskScheduler::thread_local_thread = nullptr;
   TaskScheduler::ThreadPool* TaskScheduler::threadPool = nullptr;
+  TaskScheduler::IdlePolicy TaskScheduler::idlePolicy;
+  static TaskScheduler::Statistics g_statistics;
 
   template<typename Predicate, typename Body>
-  __forceinline void TaskScheduler::steal_loop(Thread& thread, const Predicate& pred, const Body& body)
+  __forceinline void TaskScheduler::steal_loop(Thread& thread, const Predicate& pred, const Body& body, bool parkIdle)
   {
+    const size_t spinRounds = idlePolicy.spinRounds;
+    const size_t yieldRounds = idlePolicy.yieldRounds;
+    parkIdle &= idlePolicy.park;
+
+    size_t t0 = read_tsc();
     while (true)
     {
       /*! some rounds that yield */
-      for (size_t i=0; i<32; i++)
+      for (size_t i=0; i<=yieldRounds; i++)
       {
         /*! some spinning rounds */
         const size_t threadCount = thread.threadCount();
-        for (size_t j=0; j<1024; j+=threadCount)
+        for (size_t j=0; j<spinRounds; j+=threadCount)
         {
-          if (!pred()) return;
+          if (!pred()) {
+            thread.stats.idleCycles += read_tsc()-t0;
+            return;
+          }
           if (thread.scheduler->steal_from_other_threads(thread)) {
             i=j=0;
+            const size_t t1 = read_tsc();
+            thread.stats.idleCycles += t1-t0;
+            thread.stats.steals++;
+            const size_t counted = thread.stats.cycles();
             body();
+            t0 = read_tsc();
+            /* nested steal loops inside the body already counted their cycles */
+            thread.stats.workCycles += (t0-t1) - (thread.stats.cycles()-counted);
           }
         }
+        if (i < yieldRounds) {
+          thread.stats.yields++;
+          yield();
+        }
+      }
+
+      /*! park idle worker threads instead of yielding forever */
+      if (parkIdle) {
+        thread.stats.idleCycles += read_tsc()-t0;
+        thread.stats.parks++;
+        thread.scheduler->park(pred);
+        t0 = read_tsc();
+      }
+      else {
+        thread.stats.yields++;
         yield();
       }
     }
   }
 
+  template<typename Predicate>
+  __forceinline void TaskScheduler::park(const Predicate& pred)
+  {
+    Lock<MutexSys> lock(parkMutex);
+    const size_t epoch = parkEpoch;
+
+    /* pushing threads wake us up if they see this counter set, otherwise we see their tasks */
+    numParkedThreads++;
+    if (pred() && !anyTasksToSteal())
+      parkCondition.wait(parkMutex, [&] () { return parkEpoch != epoch || !pred(); });
+    numParkedThreads--;
+  }
+
+  bool TaskScheduler::anyTasksToSteal()
+  {
+    const size_t threadCount = this->threadCounter;
+    for (size_t i=0; i<threadCount; i++)
+    {
+      Thread* othread = threadLocal[i].load();
+      if (othread && othread->tasks.left < othread->tasks.right)
+        return true;
+    }
+    return false;
+  }
+
+  dll_export void TaskScheduler::wakeParkedThreads()
+  {
+    Lock<MutexSys> lock(parkMutex);
+    parkEpoch++;
+    parkCondition.notify_all();
+  }
+
+  dll_export void TaskScheduler::Statistics::add(const Statistics& other)
+  {
+    workCycles += other.workCycles;
+    idleCycles += other.idleCycles;
+    steals += other.steals;
+    yields += other.yields;
+    parks += other.parks;
+  }
+
+  void TaskScheduler::Statistics::print() const
+  {
+    const double total = double(workCycles+idleCycles);
+    std::cout << "task scheduler statistics:" << std::endl;
+    std::cout << "  work cycles = " << workCycles << " (" << (total ? 100.0*workCycles/total : 0.0) << "%)" << std::endl;
+    std::cout << "  idle cycles = " << idleCycles << " (" << (total ? 100.0*idleCycles/total : 0.0) << "%)" << std::endl;
+    std::cout << "  steals = " << steals << ", yields = " << yields << ", parks = " << parks << std::endl;
+  }
+
+  void TaskScheduler::Statistics::reset()
+  {
+    workCycles = 0;
+    idleCycles = 0;
+    steals = 0;
+    yields = 0;
+    parks = 0;
+  }
+
   /*! run this task */
   void TaskScheduler::Task::run_internal (Thread& thread) // FIXME: avoid as many dll_exports as possible
   {
@@ -62,7 +154,8 @@ namespace embree
     /* steal until all dependencies have completed */
     steal_loop(thread,
                [&] () { return dependencies>0; },
-               [&] () { while (thread.tasks.execute_local_internal(thread,this)); });
+               [&] () { while (thread.tasks.execute_local_internal(thread,this)); },
+               false);
 
     /* now signal our parent task that we are finished */
     if (parent)
@@ -138,7 +231,7 @@ namespace embree
   }
 
   TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false), maxPriority(std::numeric_limits<int>::min()) {}
 
   dll_export void TaskScheduler::ThreadPool::startThreads()
   {
@@ -195,7 +288,16 @@ namespace embree
   dll_export void TaskScheduler::ThreadPool::add(const Ref<TaskScheduler>& scheduler)
   {
     mutex.lock();
-    schedulers.push_back(scheduler);
+    std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin();
+    while (it != schedulers.end() && (*it)->priority >= scheduler->priority) it++;
+    schedulers.insert(it,scheduler);
+    updateMaxPriority();
+
+    /* parked threads of lower priority schedulers have to help the new scheduler */
+    for (it = schedulers.begin(); it != schedulers.end(); it++) {
+      if ((*it)->priority < scheduler->priority && (*it)->numParkedThreads > 0)
+        (*it)->wakeParkedThreads();
+    }
     mutex.unlock();
     condition.notify_all();
   }
@@ -206,11 +308,51 @@ namespace embree
     for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++) {
       if (scheduler == *it) {
         schedulers.erase(it);
+        updateMaxPriority();
         return;
       }
     }
   }
 
+  Ref<TaskScheduler> TaskScheduler::ThreadPool::acquire(int minPriority, ssize_t& threadIndex)
+  {
+    Ref<TaskScheduler> scheduler = nullptr;
+    for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++)
+    {
+      if ((*it)->priority < minPriority) break;
+      if ((*it)->acceptsThreads()) {
+        scheduler = *it;
+        threadIndex = scheduler->allocThreadIndex();
+        break;
+      }
+    }
+    updateMaxPriority();
+    return scheduler;
+  }
+
+  void TaskScheduler::ThreadPool::updateMaxPriority()
+  {
+    int priority = std::numeric_limits<int>::min();
+    for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++) {
+      if ((*it)->acceptsThreads()) {
+        priority = (*it)->priority;
+        break;
+      }
+    }
+    maxPriority = priority;
+  }
+
+  void TaskScheduler::ThreadPool::run_preempting(int priority)
+  {
+    ssize_t threadIndex = -1;
+    Ref<TaskScheduler> scheduler = nullptr;
+    {
+      Lock<MutexSys> lock(mutex);
+      scheduler = acquire(priority+1,threadIndex);
+    }
+    if (scheduler) scheduler->thread_loop(threadIndex);
+  }
+
   void TaskScheduler::ThreadPool::thread_loop(size_t globalThreadIndex)
   {
     while (globalThreadIndex < numThreadsRunning)
@@ -219,20 +361,19 @@ namespace embree
       ssize_t threadIndex = -1;
       {
         Lock<MutexSys> lock(mutex);
-        condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || !schedulers.empty(); });
+        condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || maxPriority > std::numeric_limits<int>::min(); });
         if (globalThreadIndex >= numThreadsRunning) break;
-        scheduler = schedulers.front();
-        threadIndex = scheduler->allocThreadIndex();
+        scheduler = acquire(std::numeric_limits<int>::min(),threadIndex);
       }
-      scheduler->thread_loop(threadIndex);
+      if (scheduler) scheduler->thread_loop(threadIndex);
     }
   }
 
-  TaskScheduler::TaskScheduler()
-    : threadCounter(0), anyTasksRunning(0), hasRootTask(false)
+  TaskScheduler::TaskScheduler(size_t maxThreads, int priority)
+    : maxThreads(maxThreads), priority(priority), threadCounter(0), anyTasksRunning(0), hasRootTask(false), numParkedThreads(0), parkEpoch(0)
   {
     assert(threadPool);
-    threadLocal.resize(2 * TaskScheduler::threadCount()); // FIXME: this has to be 2x as in the compatibility join mode with rtcCommitScene the worker threads also join. When disallowing rtcCommitScene to join a build we can remove the 2x.
+    threadLocal.resize(2 * threadPool->size()); // FIXME: this has to be 2x as in the compatibility join mode with rtcCommitScene the worker threads also join. When disallowing rtcCommitScene to join a build we can remove the 2x.
     for (size_t i=0; i<threadLocal.size(); i++)
       threadLocal[i].store(nullptr);
   }
@@ -244,6 +385,8 @@ namespace embree
 
   dll_export size_t TaskScheduler::threadID()
   {
+    if (ExternalTaskScheduler::enabled())
+      return ExternalTaskScheduler::threadIndex();
     Thread* thread = TaskScheduler::thread();
     if (thread) return thread->threadIndex;
     else        return 0;
@@ -251,12 +394,16 @@ namespace embree
 
   dll_export size_t TaskScheduler::threadIndex()
   {
+    if (ExternalTaskScheduler::enabled())
+      return ExternalTaskScheduler::threadIndex();
     Thread* thread = TaskScheduler::thread();
     if (thread) return thread->threadIndex;
     else        return 0;
   }
 
   dll_export size_t TaskScheduler::threadCount() {
+    if (ExternalTaskScheduler::enabled())
+      return ExternalTaskScheduler::threadCount();
     return threadPool->size();
   }
 
@@ -280,6 +427,14 @@ namespace embree
     delete threadPool; threadPool = nullptr;
   }
 
+  void TaskScheduler::setIdlePolicy(const IdlePolicy& policy) {
+    idlePolicy = policy;
+  }
+
+  dll_export TaskScheduler::Statistics& TaskScheduler::statistics() {
+    return g_statistics;
+  }
+
   dll_export ssize_t TaskScheduler::allocThreadIndex()
   {
     size_t threadIndex = threadCounter++;
@@ -337,15 +492,22 @@ namespace embree
     while (anyTasksRunning)
     {
       steal_loop(thread,
-                 [&] () { return anyTasksRunning > 0; },
+                 [&] () { return anyTasksRunning > 0 && !threadPool->preempts(priority); },
                  [&] () {
                    anyTasksRunning++;
                    while (thread.tasks.execute_local_internal(thread,nullptr));
-                   anyTasksRunning--;
-                 });
+                   if (--anyTasksRunning == 0 && numParkedThreads > 0)
+                     wakeParkedThreads();
+                 },
+                 true);
+
+      /* help schedulers of higher priority before stealing from this one again */
+      if (anyTasksRunning > 0 && threadPool->preempts(priority))
+        threadPool->run_preempting(priority);
     }
     threadLocal[threadIndex].store(nullptr);
     swapThread(oldThread);
+    statistics().add(thread.stats);
 
     /* wait for all threads to terminate */
     threadCounter--;
@@ -10,6 +10,7 @@
 #include "../sys/mutex.h"
 #include "../sys/condition.h"
 #include "../sys/ref.h"
+#include "taskschedulerexternal.h"
 #include "../sys/atomic.h"
 #include "../math/range.h"
 #include "../../include/embree4/rtcore.h"
@@ -150,6 +151,10 @@ namespace embree
 
 	/* also move left pointer */
 	if (left >= right-1) left = right-1;
+
+        /* wake up parked threads to steal the new task */
+        if (unlikely(thread.scheduler->numParkedThreads > 0))
+          thread.scheduler->wakeParkedThreads();
       }
 
       dll_export bool execute_local(Thread& thread, Task* parent);
@@ -171,6 +176,38 @@ namespace embree
       size_t stackPtr;
     };
 
+    /*! policy of threads waiting for tasks to steal */
+    struct IdlePolicy
+    {
+      IdlePolicy ()
+      : spinRounds(1024), yieldRounds(32), park(true) {}
+
+      size_t spinRounds;   //!< number of steal attempts before yielding
+      size_t yieldRounds;  //!< number of yields before parking
+      bool park;           //!< parks idle worker threads until new tasks get pushed
+    };
+
+    /*! counters of how threads spend their time */
+    struct Statistics
+    {
+      Statistics ()
+      : workCycles(0), idleCycles(0), steals(0), yields(0), parks(0) {}
+
+      dll_export void add(const Statistics& other);
+      void print() const;
+      void reset();
+
+      __forceinline size_t cycles() const {
+        return workCycles + idleCycles;
+      }
+
+      std::atomic<size_t> workCycles;  //!< cycles spent executing stolen tasks
+      std::atomic<size_t> idleCycles;  //!< cycles spent spinning and yielding while waiting for tasks
+      std::atomic<size_t> steals;      //!< number of stolen tasks
+      std::atomic<size_t> yields;      //!< number of yields while waiting for tasks
+      std::atomic<size_t> parks;       //!< number of times a thread got parked
+    };
+
     /*! thread local structure for each thread */
     struct Thread
     {
@@ -187,6 +224,7 @@ namespace embree
       TaskQueue tasks;                 //!< local task queue
       Task* task;                      //!< current active task
       Ref<TaskScheduler> scheduler;     //!< pointer to task scheduler
+      Statistics stats;                //!< counters of this thread, accumulated when the thread leaves
     };
 
     /*! pool of worker threads */
@@ -213,6 +251,22 @@ namespace embree
       /*! main loop for all threads */
       void thread_loop(size_t threadIndex);
 
+      /*! returns true if a scheduler of higher priority can accept more threads */
+      __forceinline bool preempts(int priority) const {
+        return maxPriority > priority;
+      }
+
+      /*! lets the calling thread work for a scheduler of higher priority until that one finishes */
+      void run_preempting(int priority);
+
+    private:
+
+      /*! returns the first scheduler of at least the specified priority that can accept more threads */
+      Ref<TaskScheduler> acquire(int minPriority, ssize_t& threadIndex);
+
+      /*! updates the highest priority of all schedulers that can accept more threads */
+      void updateMaxPriority();
+
     private:
       std::atomic<size_t> numThreads;
       std::atomic<size_t> numThreadsRunning;
@@ -223,10 +277,11 @@ namespace embree
     private:
       MutexSys mutex;
       ConditionSys condition;
-      std::list<Ref<TaskScheduler> > schedulers;
+      std::list<Ref<TaskScheduler> > schedulers; //!< ordered by decreasing priority
+      std::atomic<int> maxPriority;
     };
 
-    TaskScheduler ();
+    TaskScheduler (size_t maxThreads = 0, int priority = 0);
     ~TaskScheduler ();
 
     /*! initializes the task scheduler */
@@ -235,6 +290,12 @@ namespace embree
     /*! destroys the task scheduler again */
     static void destroy();
 
+    /*! sets the policy of threads waiting for tasks */
+    static void setIdlePolicy(const IdlePolicy& policy);
+
+    /*! returns the counters accumulated by all threads that left the scheduler */
+    dll_export static Statistics& statistics();
+
     /*! lets new worker threads join the tasking system */
     void join();
     void reset();
@@ -242,6 +303,11 @@ namespace embree
     /*! let a worker thread allocate a thread index */
     dll_export ssize_t allocThreadIndex();
 
+    /*! returns true if the thread pool may add another thread to this scheduler */
+    __forceinline bool acceptsThreads() const {
+      return maxThreads == 0 || threadCounter < maxThreads;
+    }
+
     /*! wait for some number of threads available (threadCount includes main thread) */
     void wait_for_threads(size_t threadCount);
 
@@ -252,7 +318,17 @@ namespace embree
     bool steal_from_other_threads(Thread& thread);
 
     template<typename Predicate, typename Body>
-      static void steal_loop(Thread& thread, const Predicate& pred, const Body& body);
+      static void steal_loop(Thread& thread, const Predicate& pred, const Body& body, bool parkIdle);
+
+    /*! parks an idle worker thread until new tasks get pushed or pred becomes false */
+    template<typename Predicate>
+      void park(const Predicate& pred);
+
+    /*! returns true if some thread has tasks that can get stolen */
+    bool anyTasksToSteal();
+
+    /*! wakes up all parked threads */
+    dll_export void wakeParkedThreads();
 
     /* spawn a new task at the top of the threads task stack */
     template<typename Closure>
@@ -277,11 +353,13 @@ namespace embree
       if (useThreadPool) addScheduler(this);
 
       while (thread.tasks.execute_local(thread,nullptr));
-      anyTasksRunning--;
+      if (--anyTasksRunning == 0 && numParkedThreads > 0)
+        wakeParkedThreads();
       if (useThreadPool) removeScheduler(this);
 
       threadLocal[threadIndex] = nullptr;
       swapThread(oldThread);
+      statistics().add(thread.stats);
 
       /* remember exception to throw */
       std::exception_ptr except = nullptr;
@@ -362,6 +440,8 @@ namespace embree
     dll_export static void removeScheduler(const Ref<TaskScheduler>& scheduler);
 
   private:
+    const size_t maxThreads; //!< maximal number of threads including the root thread, 0 for unlimited
+    const int priority;      //!< threads prefer schedulers of higher priority
     std::vector<atomic<Thread*>> threadLocal;
     std::atomic<size_t> threadCounter;
     std::atomic<size_t> anyTasksRunning;
@@ -370,6 +450,13 @@ namespace embree
     ConditionSys condition;
 
   private:
+    std::atomic<size_t> numParkedThreads; //!< number of parked threads
+    size_t parkEpoch;                     //!< incremented to wake up parked threads
+    MutexSys parkMutex;
+    ConditionSys parkCondition;
+
+  private:
+    static IdlePolicy idlePolicy;
     static size_t g_numThreads;
     static __thread TaskScheduler* g_instance;
     static __thread Thread* thread_local_thread;
@@ -10,6 +10,7 @@
 #include "../sys/mutex.h"
 #include "../sys/condition.h"
 #include "../sys/ref.h"
+#include "taskschedulerexternal.h"
 
 #if !defined(__WIN32__)
 #error PPL tasking system only available under windows
@@ -35,11 +36,15 @@ namespace embree
     /* returns the index (0..threadCount-1) of the current thread */
     /* FIXME: threadIndex is NOT supported by PPL! */
     static __forceinline size_t threadIndex() {
+      if (ExternalTaskScheduler::enabled())
+        return ExternalTaskScheduler::threadIndex();
       return 0;
     }
 
     /* returns the total number of threads */
     static __forceinline size_t threadCount() {
+      if (ExternalTaskScheduler::enabled())
+        return ExternalTaskScheduler::threadCount();
       return GetMaximumProcessorCount(ALL_PROCESSOR_GROUPS) + 1;
     }
   };
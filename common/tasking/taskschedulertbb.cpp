@@ -18,7 +18,7 @@ namespace embree
   public:
 
     void on_scheduler_entry( bool ) {
-      setAffinity(TaskScheduler::threadIndex());
+      setAffinity(TaskScheduler::tbbThreadIndex());
     }
 
   } tbb_affinity;
@@ -46,11 +46,11 @@ namespace embree
 
     /* now either keep default settings or configure number of threads */
     if (numThreads == std::numeric_limits<size_t>::max()) {
-      numThreads = threadCount();
+      numThreads = tbbThreadCount();
     }
     else {
       g_tbb_threads_initialized = true;
-      const size_t max_concurrency = threadCount();
+      const size_t max_concurrency = tbbThreadCount();
       if (numThreads > max_concurrency) numThreads = max_concurrency;
 #if TBB_INTERFACE_VERSION >= 11005
       g_tbb_thread_control = new tbb::global_control(tbb::global_control::max_allowed_parallelism,numThreads);
@@ -10,6 +10,7 @@
 #include "../sys/mutex.h"
 #include "../sys/condition.h"
 #include "../sys/ref.h"
+#include "taskschedulerexternal.h"
 
 #if defined(__WIN32__) && !defined(NOMINMAX)
 #  define NOMINMAX
@@ -62,6 +63,22 @@ namespace embree
     /* returns the index (0..threadCount-1) of the current thread */
     static __forceinline size_t threadIndex()
     {
+      if (ExternalTaskScheduler::enabled())
+        return ExternalTaskScheduler::threadIndex();
+      return tbbThreadIndex();
+    }
+
+    /* returns the total number of threads */
+    static __forceinline size_t threadCount()
+    {
+      if (ExternalTaskScheduler::enabled())
+        return ExternalTaskScheduler::threadCount();
+      return tbbThreadCount();
+    }
+
+    /* returns the index of the current thread inside the TBB arena */
+    static __forceinline size_t tbbThreadIndex()
+    {
 #if TBB_INTERFACE_VERSION >= 9100
       return tbb::this_task_arena::current_thread_index();
 #elif TBB_INTERFACE_VERSION >= 9000
@@ -71,8 +88,8 @@ namespace embree
 #endif
     }
 
-    /* returns the total number of threads */
-    static __forceinline size_t threadCount() {
+    /* returns the total number of TBB threads */
+    static __forceinline size_t tbbThreadCount() {
 #if TBB_INTERFACE_VERSION >= 9100
       return tbb::this_task_arena::max_concurrency();
 #else
@@ -150,6 +150,12 @@ enum RTCFormat
   RTC_FORMAT_GRID = 0xA001,
 
   RTC_FORMAT_QUATERNION_DECOMPOSITION = 0xB001,
+
+  /* 16-bit half precision float */
+  RTC_FORMAT_HALF = 0xC001,
+  RTC_FORMAT_HALF2,
+  RTC_FORMAT_HALF3,
+  RTC_FORMAT_HALF4,
 };
 
 /* Build quality levels */
@@ -161,6 +167,14 @@ enum RTCBuildQuality
   RTC_BUILD_QUALITY_REFIT  = 3,
 };
 
+/* Build priority levels of concurrent scene builds */
+enum RTCBuildPriority
+{
+  RTC_BUILD_PRIORITY_LOW    = 0,
+  RTC_BUILD_PRIORITY_NORMAL = 1,
+  RTC_BUILD_PRIORITY_HIGH   = 2,
+};
+
 /* Axis-aligned bounding box representation */
 struct RTC_ALIGN(16) RTCBounds
 {
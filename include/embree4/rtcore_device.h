@@ -105,4 +105,19 @@ typedef bool (*RTCMemoryMonitorFunction)(void* ptr, ssize_t bytes, bool post);
 /* Sets the memory monitor callback function. */
 RTC_API void rtcSetDeviceMemoryMonitorFunction(RTCDevice device, RTCMemoryMonitorFunction memoryMonitor, void* userPtr);
 
+/* Task callback function invoked for a subrange of a parallel for loop */
+typedef void (*RTCTaskFunction)(void* taskPtr, size_t taskBegin, size_t taskEnd);
+
+/* Tasking functions of an external job system */
+struct RTCTaskingFunctions
+{
+  void (*parallelFor)(void* userPtr, size_t begin, size_t end, size_t blockSize, RTCTaskFunction task, void* taskPtr);
+  unsigned int (*threadIndex)(void* userPtr);
+  unsigned int (*threadCount)(void* userPtr);
+  void* userPtr;
+};
+
+/* Sets the tasking functions used for all parallel work of Embree. */
+RTC_API void rtcSetDeviceTaskingFunctions(RTCDevice device, const struct RTCTaskingFunctions* functions);
+
 RTC_NAMESPACE_END
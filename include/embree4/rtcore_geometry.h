@@ -91,6 +91,8 @@ struct RTCIntersectFunctionNArguments
   struct RTCRayHitN* rayhit;
   unsigned int N;
   unsigned int geomID;
+  const unsigned int* primIDs;
+  unsigned int primCount;
 };
 
 /* Arguments for RTCOccludedFunctionN */
@@ -103,6 +105,8 @@ struct RTCOccludedFunctionNArguments
   struct RTCRayN* ray;
   unsigned int N;
   unsigned int geomID;
+  const unsigned int* primIDs;
+  unsigned int primCount;
 };
 
 /* Arguments for RTCDisplacementFunctionN */
@@ -155,6 +159,9 @@ RTC_API void rtcSetGeometryTimeRange(RTCGeometry geometry, float startTime, floa
 /* Sets the number of vertex attributes of the geometry. */
 RTC_API void rtcSetGeometryVertexAttributeCount(RTCGeometry geometry, unsigned int vertexAttributeCount);
 
+/* Sets the scale and offset that decode the RTC_FORMAT_SHORT3 vertex positions of the geometry. */
+RTC_API void rtcSetGeometryVertexQuantization(RTCGeometry geometry, const float* scale, const float* offset);
+
 /* Sets the ray mask of the geometry. */
 RTC_API void rtcSetGeometryMask(RTCGeometry geometry, unsigned int mask);
 
@@ -180,6 +187,9 @@ RTC_API void* rtcGetGeometryBufferData(RTCGeometry geometry, enum RTCBufferType
 /* Updates a geometry buffer. */
 RTC_API void rtcUpdateGeometryBuffer(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot);
 
+/* Updates a range of items of a geometry buffer. */
+RTC_API void rtcUpdateGeometryBufferRange(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot, size_t itemOffset, size_t itemCount);
+
 
 /* Sets the intersection filter callback function of the geometry. */
 RTC_API void rtcSetGeometryIntersectFilterFunction(RTCGeometry geometry, RTCFilterFunctionN filter);
@@ -187,6 +197,12 @@ RTC_API void rtcSetGeometryIntersectFilterFunction(RTCGeometry geometry, RTCFilt
 /* Sets the occlusion filter callback function of the geometry. */
 RTC_API void rtcSetGeometryOccludedFilterFunction(RTCGeometry geometry, RTCFilterFunctionN filter);
 
+/* Sets the opacity of all primitives of the geometry used by transmittance queries. */
+RTC_API void rtcSetGeometryOpacity(RTCGeometry geometry, float opacity);
+
+/* Sets a shared buffer with one opacity per primitive used by transmittance queries, overriding the geometry opacity. */
+RTC_API void rtcSetGeometryOpacityBuffer(RTCGeometry geometry, const float* opacity);
+
 /* Enables argument version of intersection or occlusion filter function. */
 RTC_API void rtcSetGeometryEnableFilterFunctionFromArguments(RTCGeometry geometry, bool enable);
 
@@ -211,6 +227,9 @@ RTC_API void rtcSetGeometryIntersectFunction(RTCGeometry geometry, RTCIntersectF
 /* Set the occlusion callback function of a user geometry. */
 RTC_API void rtcSetGeometryOccludedFunction(RTCGeometry geometry, RTCOccludedFunctionN occluded);
 
+/* Enables batched invocation of the intersect and occluded callbacks of a user geometry for all primitives of a BVH leaf. */
+RTC_API void rtcSetGeometryEnableBatchedCallbacks(RTCGeometry geometry, bool enable);
+
 /* Invokes the intersection filter from the intersection callback function. */
 RTC_SYCL_API void rtcInvokeIntersectFilterFromGeometry(const struct RTCIntersectFunctionNArguments* args, const struct RTCFilterFunctionNArguments* filterArgs);
 
@@ -51,6 +51,19 @@ struct RTCRayHit
   struct RTCHit hit;
 };
 
+/* Maximum number of hits reported by a multi-hit ray query */
+#define RTC_MAX_MULTI_HIT_COUNT 16
+
+/* Ray structure for a single ray that reports multiple hits sorted by distance */
+struct RTC_ALIGN(16) RTCRayMultiHit
+{
+  struct RTCRay ray;
+  struct RTCHit hit[RTC_MAX_MULTI_HIT_COUNT]; // hits sorted by increasing distance
+  float tfar[RTC_MAX_MULTI_HIT_COUNT];        // hit distances
+  unsigned int maxHitCount;                   // number of hits to gather (at most RTC_MAX_MULTI_HIT_COUNT)
+  unsigned int hitCount;                      // number of hits found (set by the query)
+};
+
 /* Ray structure for a packet of 4 rays */
 struct RTC_ALIGN(16) RTCRay4
 {
@@ -121,6 +121,9 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Commits multiple scenes in a single parallel operation. */
+RTC_API void rtcCommitScenes(RTCScene* scenes, size_t numScenes);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -131,6 +134,12 @@ RTC_API void rtcSetSceneProgressMonitorFunction(RTCScene scene, RTCProgressMonit
 /* Sets the build quality of the scene. */
 RTC_API void rtcSetSceneBuildQuality(RTCScene scene, enum RTCBuildQuality quality);
 
+/* Limits the number of threads that build the scene. */
+RTC_API void rtcSetSceneBuildThreadCount(RTCScene scene, unsigned int threadCount);
+
+/* Sets the priority of the scene build relative to concurrent builds. */
+RTC_API void rtcSetSceneBuildPriority(RTCScene scene, enum RTCBuildPriority priority);
+
 /* Sets the scene flags. */
 RTC_API void rtcSetSceneFlags(RTCScene scene, enum RTCSceneFlags flags);
 
@@ -169,6 +178,9 @@ RTC_API void rtcIntersect8(const int* valid, RTCScene scene, struct RTCRayHit8*
 /* Intersects a packet of 16 rays with the scene. */
 RTC_API void rtcIntersect16(const int* valid, RTCScene scene, struct RTCRayHit16* rayhit, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
 
+/* Intersects a single ray with the scene and gathers the closest hits sorted by distance. */
+RTC_API void rtcIntersectMultiHit(RTCScene scene, struct RTCRayMultiHit* rayhit, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
 
 /* Forwards ray inside user geometry callback. */
 RTC_SYCL_API void rtcForwardIntersect1(const struct RTCIntersectFunctionNArguments* args, RTCScene scene, struct RTCRay* ray, unsigned int instID);
@@ -208,6 +220,19 @@ RTC_API void rtcOccluded8(const int* valid, RTCScene scene, struct RTCRay8* ray,
 RTC_API void rtcOccluded16(const int* valid, RTCScene scene, struct RTCRay16* ray, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
 
 
+/* Accumulates the transmittance of a single ray through semi-transparent geometries, the ray is occluded once the transmittance drops below minTransmittance. */
+RTC_API void rtcTransmittance1(RTCScene scene, struct RTCRay* ray, float* transmittance, float minTransmittance, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Accumulates the transmittance of a packet of 4 rays through semi-transparent geometries. */
+RTC_API void rtcTransmittance4(const int* valid, RTCScene scene, struct RTCRay4* ray, float* transmittance, float minTransmittance, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Accumulates the transmittance of a packet of 8 rays through semi-transparent geometries. */
+RTC_API void rtcTransmittance8(const int* valid, RTCScene scene, struct RTCRay8* ray, float* transmittance, float minTransmittance, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Accumulates the transmittance of a packet of 16 rays through semi-transparent geometries. */
+RTC_API void rtcTransmittance16(const int* valid, RTCScene scene, struct RTCRay16* ray, float* transmittance, float minTransmittance, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
+
+
 /* Forwards single occlusion ray inside user geometry callback. */
 RTC_SYCL_API void rtcForwardOccluded1(const struct RTCOccludedFunctionNArguments* args, RTCScene scene, struct RTCRay* ray, unsigned int instID);
 
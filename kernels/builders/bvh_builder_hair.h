@@ -190,10 +190,10 @@ namespace embree
               bestSAH = min(unalignedObjectSAH,bestSAH);
             }
 
-            /* try splitting into two strands */
+            /* try splitting into two strands, large sets use sampled orientation clustering */
             HeuristicStrandSplitSAH::Split strandSplit;
             float strandSAH = inf;
-            if (bestSAH > 0.7f*leafSAH && pinfo.size() <= 256) {
+            if (bestSAH > 0.7f*leafSAH && (pinfo.size() <= 256 || pinfo.size() >= HeuristicStrandSplitSAH::PARALLEL_THRESHOLD)) {
               strandSplit = strandHeuristic.find(pinfo,cfg.logBlockSize);
               strandSAH = travCostUnaligned*halfArea(pinfo.geomBounds) + intCost*strandSplit.splitSAH();
               bestSAH = min(strandSAH,bestSAH);
@@ -302,10 +302,11 @@ namespace embree
 
             /*! sort morton codes */
 #if defined(TASKING_TBB)
-            tbb::parallel_sort(morton+current.begin(),morton+current.end());
-#else
-            radixsort32(morton+current.begin(),current.size());
+            if (!ExternalTaskScheduler::enabled())
+              tbb::parallel_sort(morton+current.begin(),morton+current.end());
+            else
 #endif
+            radixsort32(morton+current.begin(),current.size());
           }
         }
 
@@ -24,25 +24,47 @@ namespace embree
         __forceinline UnalignedHeuristicArrayBinningSAH (Scene* scene, PrimRef* prims)
           : scene(scene), prims(prims) {}
 
-        const LinearSpace3fa computeAlignedSpace(const range<size_t>& set)
+        /*! curve with minimum ID that defines a valid direction */
+        struct MinDirection
         {
-          Vec3fa axis(0,0,1);
-          uint64_t bestGeomPrimID = -1;
+          __forceinline MinDirection () 
+            : geomprimID(-1), axis(0,0,1) {}
 
-          /*! find curve with minimum ID that defines valid direction */
-          for (size_t i=set.begin(); i<set.end(); i++)
-          {
-            const unsigned int geomID = prims[i].geomID();
-            const unsigned int primID = prims[i].primID();
-            const uint64_t geomprimID = prims[i].ID64();
-            if (geomprimID >= bestGeomPrimID) continue;
-            const Vec3fa axis1 = scene->get(geomID)->computeDirection(primID);
-            if (sqr_length(axis1) > 1E-18f) {
-              axis = normalize(axis1);
-              bestGeomPrimID = geomprimID;
-            }
+          __forceinline MinDirection (uint64_t geomprimID, const Vec3fa& axis)
+            : geomprimID(geomprimID), axis(axis) {}
+
+          static __forceinline const MinDirection merge (const MinDirection& a, const MinDirection& b) {
+            return a.geomprimID <= b.geomprimID ? a : b;
           }
-          return frame(axis).transposed();
+
+          uint64_t geomprimID;
+          Vec3fa axis;
+        };
+
+        const LinearSpace3fa computeAlignedSpace(const range<size_t>& set)
+        {
+          /*! find curve with minimum ID that defines valid direction */
+          auto findMinDirection = [&] (const range<size_t>& r) -> MinDirection
+            {
+              MinDirection best;
+              for (size_t i=r.begin(); i<r.end(); i++)
+              {
+                const unsigned int geomID = prims[i].geomID();
+                const unsigned int primID = prims[i].primID();
+                const uint64_t geomprimID = prims[i].ID64();
+                if (geomprimID >= best.geomprimID) continue;
+                const Vec3fa axis1 = scene->get(geomID)->computeDirection(primID);
+                if (sqr_length(axis1) > 1E-18f)
+                  best = MinDirection(geomprimID,normalize(axis1));
+              }
+              return best;
+            };
+
+          /* the reduction picks the minimum ID, thus the result does not depend on the task decomposition */
+          const MinDirection best = parallel_reduce(set.begin(), set.end(), size_t(1024), size_t(4096),
+                                                    MinDirection(), findMinDirection, MinDirection::merge);
+          
+          return frame(best.axis).transposed();
         }
         
         const PrimInfo computePrimInfo(const range<size_t>& set, const LinearSpace3fa& space)
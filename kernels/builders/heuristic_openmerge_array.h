@@ -16,6 +16,9 @@
 /* 10% spatial extend threshold */
 #define MAX_EXTEND_THRESHOLD   0.1f
 
+/* expensive build refs are opened up to that factor deeper than average ones */
+#define MAX_COST_OPEN_FACTOR   4.0f
+
 /* maximum is 8 children */
 #define MAX_OPENED_CHILD_NODES 8
 
@@ -50,25 +53,44 @@ namespace embree
           assert(max_open_size <= MAX_OPENED_CHILD_NODES);
         }
 
+        /*! opens build refs with large extent, refs that are more expensive than average are opened deeper */
         struct OpenHeuristic
         {
-          __forceinline OpenHeuristic( const PrimInfoExtRange& pinfo )
+          __forceinline OpenHeuristic( const PrimInfoExtRange& pinfo, const float avg_cost )
           {
             const Vec3fa diag = pinfo.geomBounds.size();
             dim = maxDim(diag);
             assert(diag[dim] > 0.0f);
             inv_max_extend = 1.0f / diag[dim];
+            inv_avg_cost = avg_cost > 0.0f ? 1.0f / avg_cost : 0.0f;
           }
 
-          __forceinline bool operator () ( PrimRef& prim ) const {
-            return !prim.node.isLeaf() && prim.bounds().size()[dim] * inv_max_extend > MAX_EXTEND_THRESHOLD;
+          __forceinline bool operator () ( PrimRef& prim ) const 
+          {
+            if (prim.node.isLeaf()) return false;
+            const float cost_factor = clamp(sqrt(float(prim.size()) * inv_avg_cost),1.0f,MAX_COST_OPEN_FACTOR);
+            return prim.bounds().size()[dim] * inv_max_extend * cost_factor > MAX_EXTEND_THRESHOLD;
           }
 
         private:
           size_t dim;
           float inv_max_extend;
+          float inv_avg_cost;
         };
 
+        /*! computes the average cost of all build refs, the cost is the binning weight of the ref */
+        __noinline float getAverageCost(const PrimInfoExtRange& set)
+        {
+          auto body = [&] (const range<size_t>& r) -> size_t { 
+            size_t cost = 0;
+            for (size_t i=r.begin(); i<r.end(); i++)
+              cost += prims0[i].size();
+            return cost;
+          };
+          const size_t cost = parallel_reduce(set.begin(),set.end(),PARALLEL_FIND_BLOCK_SIZE,PARALLEL_THRESHOLD,size_t(0),body,std::plus<size_t>());
+          return float(cost) / float(set.size());
+        }
+
         /*! compute extended ranges */
         __forceinline void setExtentedRanges(const PrimInfoExtRange& set, PrimInfoExtRange& lset, PrimInfoExtRange& rset, const size_t lweight, const size_t rweight)
         {
@@ -114,9 +136,9 @@ namespace embree
         }
 
         /* estimates the extra space required when opening, and checks if all primitives are from same geometry */
-        __noinline std::pair<size_t,bool> getProperties(const PrimInfoExtRange& set)
+        __noinline std::pair<size_t,bool> getProperties(const PrimInfoExtRange& set, const float avg_cost)
         {
-          const OpenHeuristic heuristic(set);
+          const OpenHeuristic heuristic(set,avg_cost);
           const unsigned int geomID = prims0[set.begin()].geomID();
           
           auto body = [&] (const range<size_t>& r) -> std::pair<size_t,bool> { 
@@ -136,9 +158,9 @@ namespace embree
         }
 
         // FIXME: should consider maximum available extended size 
-        __noinline void openNodesBasedOnExtend(PrimInfoExtRange& set)
+        __noinline void openNodesBasedOnExtend(PrimInfoExtRange& set, const float avg_cost)
         {
-          const OpenHeuristic heuristic(set);
+          const OpenHeuristic heuristic(set,avg_cost);
           const size_t ext_range_start = set.end();
 
           if (false && set.size() < PARALLEL_THRESHOLD) 
@@ -191,9 +213,9 @@ namespace embree
           }
         } 
 
-        __noinline void openNodesBasedOnExtendLoop(PrimInfoExtRange& set, const size_t est_new_elements)
+        __noinline void openNodesBasedOnExtendLoop(PrimInfoExtRange& set, const size_t est_new_elements, const float avg_cost)
         {
-          const OpenHeuristic heuristic(set);
+          const OpenHeuristic heuristic(set,avg_cost);
           size_t next_iteration_extra_elements = est_new_elements;          
           
           while (next_iteration_extra_elements <= set.ext_range_size()) 
@@ -227,7 +249,7 @@ namespace embree
             set._end += extra_elements;
 
             for (size_t i=set.begin();i<set.end();i++)
-              assert(prims0[i].numPrimitives() > 0);
+              assert(prims0[i].size() > 0);
 
             if (unlikely(next_iteration_extra_elements == 0)) break;
           }
@@ -255,11 +277,13 @@ namespace embree
           }
 
           std::pair<size_t,bool> p(0,false);
+          float avg_cost = 0.0f;
 
           /* disable opening when all primitives are from same geometry */
           if (unlikely(set.has_ext_range()))
           {
-            p =  getProperties(set);
+            avg_cost = getAverageCost(set);
+            p =  getProperties(set,avg_cost);
 #if EQUAL_GEOMID_STOP_CRITERIA == 1
             if (p.second) set.set_ext_range(set.end()); /* disable opening */
 #endif         
@@ -269,10 +293,10 @@ namespace embree
           if (unlikely(set.has_ext_range()))
           {
 #if USE_LOOP_OPENING == 1
-            openNodesBasedOnExtendLoop(set,p.first);
+            openNodesBasedOnExtendLoop(set,p.first,avg_cost);
 #else
             if (p.first <= set.ext_range_size())
-              openNodesBasedOnExtend(set);
+              openNodesBasedOnExtend(set,avg_cost);
 #endif
 
             /* disable opening when insufficient space for opening a node available */
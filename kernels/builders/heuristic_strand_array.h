@@ -19,6 +19,7 @@ namespace embree
       static const size_t PARALLEL_THRESHOLD = 10000;
       static const size_t PARALLEL_FIND_BLOCK_SIZE = 4096;
       static const size_t PARALLEL_PARTITION_BLOCK_SIZE = 64;
+      static const size_t SAMPLES = 256;
 
       /*! stores all information to perform some split */
       struct Split
@@ -61,9 +62,139 @@ namespace embree
         return scene->get(prim.geomID())->vbounds(space,prim.primID());
       }
 
+      /*! curve direction together with the ID of the curve */
+      struct IDDirection
+      {
+        __forceinline IDDirection () 
+          : cos(1.0f), geomprimID(-1), axis(0,0,1) {}
+        
+        __forceinline IDDirection (float cos, uint64_t geomprimID, const Vec3fa& axis)
+          : cos(cos), geomprimID(geomprimID), axis(axis) {}
+
+        /*! selects the curve with minimum ID */
+        static __forceinline const IDDirection minID (const IDDirection& a, const IDDirection& b) {
+          return a.geomprimID <= b.geomprimID ? a : b;
+        }
+
+        /*! selects the most misaligned curve with minimum ID */
+        static __forceinline const IDDirection minCos (const IDDirection& a, const IDDirection& b) {
+          if (a.cos != b.cos) return a.cos < b.cos ? a : b;
+          return minID(a,b);
+        }
+
+        float cos;
+        uint64_t geomprimID;
+        Vec3fa axis;
+      };
+
+      /*! primitive counts and bounds of both strands */
+      struct StrandBounds
+      {
+        __forceinline StrandBounds () 
+          : lnum(0), rnum(0), lbounds(empty), rbounds(empty) {}
+
+        static __forceinline const StrandBounds merge (const StrandBounds& a, const StrandBounds& b)
+        {
+          StrandBounds c;
+          c.lnum = a.lnum + b.lnum; c.lbounds = embree::merge(a.lbounds,b.lbounds);
+          c.rnum = a.rnum + b.rnum; c.rbounds = embree::merge(a.rbounds,b.rbounds);
+          return c;
+        }
+
+        size_t lnum, rnum;
+        BBox3fa lbounds, rbounds;
+      };
+
+      /*! calculates the sah of splitting into strands along axis0 and axis1 */
+      const Split computeSplit(const range<size_t>& set, size_t logBlockSize, const Vec3fa& axis0, const Vec3fa& axis1)
+      {
+        const LinearSpace3fa space0 = frame(axis0).transposed();
+        const LinearSpace3fa space1 = frame(axis1).transposed();
+
+        auto computeBounds = [&] (const range<size_t>& r) -> StrandBounds
+          {
+            StrandBounds sb;
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              const PrimRef& prim = prims[i];
+              const Vec3fa axisi = normalize(direction(prim));
+              const float cos0 = abs(dot(axisi,axis0));
+              const float cos1 = abs(dot(axisi,axis1));
+              
+              if (cos0 > cos1) { sb.lnum++; sb.lbounds.extend(bounds(space0,prim)); }
+              else             { sb.rnum++; sb.rbounds.extend(bounds(space1,prim)); }
+            }
+            return sb;
+          };
+
+        const StrandBounds sb = parallel_reduce(set.begin(), set.end(), PARALLEL_FIND_BLOCK_SIZE, PARALLEL_THRESHOLD,
+                                                StrandBounds(), computeBounds, StrandBounds::merge);
+      
+        /*! return an invalid split if we do not partition */
+        if (sb.lnum == 0 || sb.rnum == 0) 
+          return Split(inf,axis0,axis1);
+      
+        /*! calculate sah for the split */
+        const size_t lblocks = (sb.lnum+(1ull<<logBlockSize)-1ull) >> logBlockSize;
+        const size_t rblocks = (sb.rnum+(1ull<<logBlockSize)-1ull) >> logBlockSize;
+        const float sah = madd(float(lblocks),halfArea(sb.lbounds),float(rblocks)*halfArea(sb.rbounds));
+        return Split(sah,axis0,axis1);
+      }
+
+      /*! finds the best split by clustering the orientations of a
+       *  subset of the curves, the subset is selected by hashing the
+       *  curve IDs to keep the build deterministic */
+      const Split find_sampled(const range<size_t>& set, size_t logBlockSize)
+      {
+        const uint64_t sampleMask = (uint64_t(1) << bsr(set.size()/SAMPLES)) - 1;
+        auto sampled = [&] (const PrimRef& prim) -> bool {
+          return (((prim.ID64() * 0x9E3779B97F4A7C15ull) >> 40) & sampleMask) == 0;
+        };
+
+        /* sampled curve with minimum ID determines first axis */
+        auto findAxis0 = [&] (const range<size_t>& r) -> IDDirection
+          {
+            IDDirection best;
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              const uint64_t geomprimID = prims[i].ID64();
+              if (geomprimID >= best.geomprimID || !sampled(prims[i])) continue;
+              const Vec3fa axis = direction(prims[i]);
+              if (sqr_length(axis) > 1E-18f)
+                best = IDDirection(1.0f,geomprimID,normalize(axis));
+            }
+            return best;
+          };
+        const Vec3fa axis0 = parallel_reduce(set.begin(), set.end(), PARALLEL_FIND_BLOCK_SIZE, PARALLEL_THRESHOLD,
+                                             IDDirection(), findAxis0, IDDirection::minID).axis;
+
+        /* find sampled 2nd axis that is most misaligned with first axis and has minimum ID */
+        auto findAxis1 = [&] (const range<size_t>& r) -> IDDirection
+          {
+            IDDirection best(1.0f,-1,axis0);
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              if (!sampled(prims[i])) continue;
+              Vec3fa axisi = direction(prims[i]);
+              float leni = length(axisi);
+              if (leni == 0.0f) continue;
+              axisi /= leni;
+              best = IDDirection::minCos(best,IDDirection(abs(dot(axisi,axis0)),prims[i].ID64(),axisi));
+            }
+            return best;
+          };
+        const Vec3fa axis1 = parallel_reduce(set.begin(), set.end(), PARALLEL_FIND_BLOCK_SIZE, PARALLEL_THRESHOLD,
+                                             IDDirection(1.0f,-1,axis0), findAxis1, IDDirection::minCos).axis;
+
+        return computeSplit(set,logBlockSize,axis0,axis1);
+      }
+
       /*! finds the best split */
       const Split find(const range<size_t>& set, size_t logBlockSize)
       {
+        if (unlikely(set.size() >= PARALLEL_THRESHOLD))
+          return find_sampled(set,logBlockSize);
+
         Vec3fa axis0(0,0,1);
         uint64_t bestGeomPrimID = -1;
 
@@ -97,32 +228,7 @@ namespace embree
           }
         }
       
-        /* partition the two strands */
-        size_t lnum = 0, rnum = 0;
-        BBox3fa lbounds = empty, rbounds = empty;
-        const LinearSpace3fa space0 = frame(axis0).transposed();
-        const LinearSpace3fa space1 = frame(axis1).transposed();
-        
-        for (size_t i=set.begin(); i<set.end(); i++)
-        {
-          PrimRef& prim = prims[i];
-          const Vec3fa axisi = normalize(direction(prim));
-          const float cos0 = abs(dot(axisi,axis0));
-          const float cos1 = abs(dot(axisi,axis1));
-          
-          if (cos0 > cos1) { lnum++; lbounds.extend(bounds(space0,prim)); }
-          else             { rnum++; rbounds.extend(bounds(space1,prim)); }
-        }
-      
-        /*! return an invalid split if we do not partition */
-        if (lnum == 0 || rnum == 0) 
-          return Split(inf,axis0,axis1);
-      
-        /*! calculate sah for the split */
-        const size_t lblocks = (lnum+(1ull<<logBlockSize)-1ull) >> logBlockSize;
-        const size_t rblocks = (rnum+(1ull<<logBlockSize)-1ull) >> logBlockSize;
-        const float sah = madd(float(lblocks),halfArea(lbounds),float(rblocks)*halfArea(rbounds));
-        return Split(sah,axis0,axis1);
+        return computeSplit(set,logBlockSize,axis0,axis1);
       }
 
       /*! array partitioning */
@@ -149,7 +255,13 @@ namespace embree
           pinfo.extend(bounds(ref)); 
         };
         
-        size_t center = serial_partitioning(prims,begin,end,local_left,local_right,primOnLeftSide,mergePrimBounds);
+        size_t center = 0;
+        if (likely(set.size() < PARALLEL_THRESHOLD))
+          center = serial_partitioning(prims,begin,end,local_left,local_right,primOnLeftSide,mergePrimBounds);
+        else
+          center = parallel_partitioning(prims,begin,end,EmptyTy(),local_left,local_right,primOnLeftSide,mergePrimBounds,
+                                         [] (CentGeomBBox3fa& pinfo0,const CentGeomBBox3fa& pinfo1) { pinfo0.merge(pinfo1); },
+                                         PARALLEL_PARTITION_BLOCK_SIZE);
         
         new (&lset) PrimInfoRange(begin,center,local_left);
         new (&rset) PrimInfoRange(center,end,local_right);
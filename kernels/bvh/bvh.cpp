@@ -3,12 +3,15 @@
 
 #include "bvh.h"
 #include "bvh_statistics.h"
+#include "bvh_node_profile.h"
+
+#include <queue>
 
 namespace embree
 {
   template<int N>
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
-    : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
+    : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : (N==16) ? AccelData::TY_BVH16 : AccelData::TY_UNKNOWN),
       primTy(&primTy), device(scene->device), scene(scene),
       root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0)
   {
@@ -48,9 +51,158 @@ namespace embree
     }
   }
 
+  /* Copies the nodes of a BVH into few large memory chunks in the
+   * order they get passed to malloc. Large allocations bypass the
+   * thread local blocks of the allocator and get backed by huge pages
+   * if enabled, such that the top levels of the tree end up densely
+   * packed in the first chunk. */
+  template<int N>
+  struct BVHNodeLayout
+  {
+    typedef typename BVHN<N>::NodeRef NodeRef;
+    typedef typename BVHN<N>::AABBNode AABBNode;
+
+    BVHNodeLayout (FastAllocator* alloc, size_t numNodes)
+      : alloc(alloc), numNodes(numNodes), cur(nullptr), end(nullptr) {}
+
+    /* counts the nodes of a subtree and computes its height */
+    static size_t countNodes(NodeRef node, size_t& height)
+    {
+      height = 0;
+      if (!node.isAABBNode()) return 0;
+      AABBNode* n = node.getAABBNode();
+      size_t num = 1;
+      for (size_t c=0; c<N; c++) {
+        size_t h = 0;
+        num += countNodes(n->child(c),h);
+        height = max(height,h);
+      }
+      height++;
+      return num;
+    }
+
+    /* allocates num nodes next to each other */
+    AABBNode* malloc(size_t num)
+    {
+      const size_t bytes = num*sizeof(AABBNode);
+      if (cur+bytes > end)
+      {
+        size_t chunkBytes = min(max(numNodes*sizeof(AABBNode),bytes),size_t(2*1024*1024-CACHELINE_SIZE));
+        cur = (char*) alloc->malloc(chunkBytes,CACHELINE_SIZE,false);
+        end = cur+chunkBytes;
+      }
+      AABBNode* nodes = (AABBNode*) cur;
+      cur += bytes;
+      numNodes -= num;
+      return nodes;
+    }
+
+    /* depth first order with all children of a node stored next to each other */
+    void layoutDFS(AABBNode* node)
+    {
+      size_t num = 0;
+      for (size_t c=0; c<N; c++)
+        num += node->child(c).isAABBNode();
+      if (num == 0) return;
+
+      AABBNode* children = malloc(num);
+      for (size_t c=0, i=0; c<N; c++) {
+        if (!node->child(c).isAABBNode()) continue;
+        children[i] = *node->child(c).getAABBNode();
+        node->child(c) = BVHN<N>::encodeNode(&children[i++]);
+      }
+      for (size_t i=0; i<num; i++)
+        layoutDFS(&children[i]);
+    }
+
+    /* van Emde Boas order: the top half of the levels of a subtree is
+     * stored first, followed by each of the bottom subtrees, all laid
+     * out recursively in the same order */
+    void layoutVEB(NodeRef& ref, size_t levels)
+    {
+      if (!ref.isAABBNode()) return;
+      if (levels == 1) {
+        AABBNode* node = malloc(1);
+        *node = *ref.getAABBNode();
+        ref = BVHN<N>::encodeNode(node);
+        return;
+      }
+      const size_t top = (levels+1)/2;
+      layoutVEB(ref,top);
+      layoutBottom(ref,0,top,levels-top);
+    }
+
+    /* lays out all subtrees below the top levels, whose references still point to old nodes */
+    void layoutBottom(NodeRef& ref, size_t depth, size_t top, size_t levels)
+    {
+      if (!ref.isAABBNode()) return;
+      if (depth == top) { layoutVEB(ref,levels); return; }
+      AABBNode* node = ref.getAABBNode();
+      for (size_t c=0; c<N; c++)
+        layoutBottom(node->child(c),depth+1,top,levels);
+    }
+
+    /* Stores the most frequently visited nodes first, starting at the
+     * root, such that the hot nodes get packed into the first chunks.
+     * The children of each node get sorted by increasing visit count,
+     * as the traversal continues with the last child when hit
+     * distances are equal and for occlusion rays. */
+    void layoutProfile(NodeRef& root, const NodeProfile& profile)
+    {
+      struct Item
+      {
+        __forceinline Item (unsigned int count, NodeRef* ref)
+          : count(count), ref(ref) {}
+
+        __forceinline bool operator< (const Item& other) const {
+          return count < other.count;
+        }
+
+        unsigned int count;
+        NodeRef* ref;
+      };
+
+      std::priority_queue<Item> queue;
+      queue.push(Item(profile.count(root.getAABBNode()),&root));
+      while (!queue.empty())
+      {
+        NodeRef* ref = queue.top().ref; queue.pop();
+        AABBNode* node = malloc(1);
+        *node = *ref->getAABBNode();
+        *ref = BVHN<N>::encodeNode(node);
+
+        size_t num = 0;
+        unsigned int counts[N];
+        for (; num<N && node->child(num) != BVHN<N>::emptyNode; num++)
+          counts[num] = node->child(num).isAABBNode() ? profile.count(node->child(num).getAABBNode()) : 0;
+
+        for (size_t i=1; i<num; i++)
+          for (size_t j=i; j>0 && counts[j-1] > counts[j]; j--) {
+            std::swap(counts[j-1],counts[j]);
+            node->swap(j-1,j);
+          }
+
+        for (size_t i=0; i<num; i++)
+          if (node->child(i).isAABBNode())
+            queue.push(Item(counts[i],&node->child(i)));
+      }
+    }
+
+    FastAllocator* alloc;
+    size_t numNodes; //!< number of nodes still to allocate
+    char* cur;
+    char* end;
+  };
+
   template<int N>
   void BVHN<N>::layoutLargeNodes(size_t num)
   {
+    /* a full relayout of the tree supersedes laying out the large nodes */
+    if (device->bvh_layout == "dfs" || device->bvh_layout == "veb" || device->bvh_layout == "profile") {
+      layoutNodes(device->bvh_layout);
+      return;
+    }
+
 #if defined(__64BIT__) // do not use tree rotations on 32 bit platforms, barrier bit in NodeRef will cause issues
     struct NodeArea 
     {
@@ -109,6 +261,31 @@ namespace embree
     else return node;
   }
 
+  template<int N>
+  void BVHN<N>::layoutNodes(const std::string& order)
+  {
+    size_t height = 0;
+    const size_t numNodes = BVHNodeLayout<N>::countNodes(root,height);
+    if (numNodes <= 1) return;
+
+    /* the old nodes stay in the allocator until the BVH gets rebuilt */
+    BVHNodeLayout<N> layout(&alloc,numNodes);
+#if defined(EMBREE_BVH_NODE_PROFILE)
+    /* without recorded node visits we fall back to the depth first layout */
+    if (order == "profile" && !NodeProfile::get().empty())
+      layout.layoutProfile(root,NodeProfile::get());
+    else
+#endif
+    if (order == "veb")
+      layout.layoutVEB(root,height);
+    else {
+      AABBNode* node = layout.malloc(1);
+      *node = *root.getAABBNode();
+      root = encodeNode(node);
+      layout.layoutDFS(node);
+    }
+  }
+
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
@@ -179,6 +356,13 @@ namespace embree
     }
   }
 
+#if defined(__AVX512F__)
+  template class BVHN<16>;
+#endif
+
+/* the AVX512 library only instantiates the BVH16 */
+#if !defined(__AVX512F__) || defined(EMBREE_LOWEST_ISA)
+
 #if defined(__AVX__)
   template class BVHN<8>;
 #endif
@@ -186,5 +370,7 @@ namespace embree
 #if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42) || defined(__aarch64__)
   template class BVHN<4>;
 #endif
+
+#endif
 }
 
@@ -103,9 +103,12 @@ namespace embree
     /*! Clears the barrier bits of a subtree. */
     void clearBarrier(NodeRef& node);
     
-    /*! lays out num large nodes of the BVH */
+    /*! lays out num large nodes of the BVH, or all nodes if a node layout is selected through the bvh_layout option */
     void layoutLargeNodes(size_t num);
     NodeRef layoutLargeNodesRecursion(NodeRef& node, const FastAllocator::CachedAllocator& allocator);
+
+    /*! copies all nodes of the BVH into contiguous memory in depth first (dfs), van Emde Boas (veb), or profile guided (profile) order */
+    void layoutNodes(const std::string& order);
     
     /*! called by all builders before build starts */
     double preBuild(const std::string& builderName);
@@ -232,4 +235,5 @@ namespace embree
   
   typedef BVHN<4> BVH4;
   typedef BVHN<8> BVH8;
+  typedef BVHN<16> BVH16;
 }
@@ -0,0 +1,58 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../common/isa.h" // to define EMBREE_TARGET_SIMD16
+
+#if defined (EMBREE_TARGET_SIMD16)
+
+#include "bvh16_factory.h"
+#include "../bvh/bvh.h"
+
+#include "../geometry/triangle.h"
+#include "../common/accelinstance.h"
+
+namespace embree
+{
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH16Triangle4Intersector1Moeller);
+
+  DECLARE_ISA_FUNCTION(Builder*,BVH16Triangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+
+  BVH16Factory::BVH16Factory(int bfeatures, int ifeatures)
+  {
+    selectBuilders(bfeatures);
+    selectIntersectors(ifeatures);
+  }
+
+  void BVH16Factory::selectBuilders(int features)
+  {
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512(features,BVH16Triangle4SceneBuilderSAH));
+  }
+
+  void BVH16Factory::selectIntersectors(int features)
+  {
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512(features,BVH16Triangle4Intersector1Moeller));
+  }
+
+  Accel::Intersectors BVH16Factory::BVH16Triangle4Intersectors(BVH16* bvh, IntersectVariant ivariant)
+  {
+    assert(ivariant == IntersectVariant::FAST);
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1 = BVH16Triangle4Intersector1Moeller();
+    return intersectors;
+  }
+
+  Accel* BVH16Factory::BVH16Triangle4(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
+  {
+    BVH16* accel = new BVH16(Triangle4::type,scene);
+    Accel::Intersectors intersectors = BVH16Triangle4Intersectors(accel,ivariant);
+    Builder* builder = nullptr;
+    if      (scene->device->tri_builder == "default") builder = BVH16Triangle4SceneBuilderSAH(accel,scene,0);
+    else if (scene->device->tri_builder == "sah"    ) builder = BVH16Triangle4SceneBuilderSAH(accel,scene,0);
+    else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH16<Triangle4>");
+
+    return new AccelInstance(accel,builder,intersectors);
+  }
+}
+
+#endif
@@ -0,0 +1,33 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh_factory.h"
+
+namespace embree
+{
+  /*! BVH16 instantiations */
+  class BVH16Factory : public BVHFactory
+  {
+  public:
+    BVH16Factory(int bfeatures, int ifeatures);
+
+  public:
+    Accel* BVH16Triangle4(Scene* scene, BuildVariant bvariant = BuildVariant::STATIC, IntersectVariant ivariant = IntersectVariant::FAST);
+
+  private:
+    void selectBuilders(int features);
+    void selectIntersectors(int features);
+
+  private:
+    Accel::Intersectors BVH16Triangle4Intersectors(BVH16* bvh, IntersectVariant ivariant);
+
+  private:
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH16Triangle4Intersector1Moeller);
+
+    // SAH scene builders
+  private:
+    DEFINE_ISA_FUNCTION(Builder*,BVH16Triangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+  };
+}
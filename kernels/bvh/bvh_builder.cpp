@@ -56,5 +56,9 @@ namespace embree
     template struct BVHNBuilderQuantizedVirtual<8>;
     template struct BVHNBuilderMblurVirtual<8>;
 #endif
+
+#if defined(__AVX512F__)
+    template struct BVHNBuilderVirtual<16>;
+#endif
   }
 }
@@ -227,7 +227,7 @@ namespace embree
           upper = max(upper,(vfloat4)p0,(vfloat4)p1,(vfloat4)p2);
           vgeomID[i] = geomID_;
           vprimID[i] = primID;
-          unsigned int int_stride = mesh->vertices0.getStride()/4;
+          unsigned int int_stride = mesh->getVertexOffsetScale();
           v0[i] = tri.v[0] * int_stride; 
           v1[i] = tri.v[1] * int_stride;
           v2[i] = tri.v[2] * int_stride;
@@ -8,6 +8,7 @@
 
 #include "../geometry/linei.h"
 #include "../geometry/triangle.h"
+#include "../geometry/trianglew.h"
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglev_mb.h"
 #include "../geometry/trianglei.h"
@@ -17,6 +18,7 @@
 #include "../geometry/instance.h"
 #include "../geometry/instance_array.h"
 #include "../geometry/subgrid.h"
+#include "../geometry/mixed.h"
 
 #include "../common/state.h"
 #include "../../common/algorithms/parallel_for_for.h"
@@ -448,6 +450,148 @@ namespace embree
     /************************************************************************************/
     /************************************************************************************/
 
+    /*! Builds a single BVH over all static triangles, quads, curves,
+     *  user geometries, and instances of the scene. Each leaf only
+     *  contains primitives of one type, leaves of different types are
+     *  separated by type splits when the SAH would merge them. */
+    template<int N>
+    struct BVHNBuilderMixedSAH : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVHN<N>::NodeRef NodeRef;
+
+      BVH* bvh;
+      Scene* scene;
+      mvector<PrimRef> prims;
+      GeneralBVHBuilder::Settings settings;
+
+      BVHNBuilderMixedSAH (BVH* bvh, Scene* scene)
+        : bvh(bvh), scene(scene), prims(scene->device,0),
+          settings(4, 1, 4*BVH::maxLeafBlocks, travCost, 1.0f, DEFAULT_SINGLE_THREAD_THRESHOLD) {}
+
+      /* returns the maximal number of primitives a leaf of some type can hold */
+      __forceinline size_t maxLeafSize(unsigned int ty) const
+      {
+        switch (ty) {
+        case Geometry::GTY_TRIANGLE_MESH : return Triangle4::max_size()*BVH::maxLeafBlocks;
+        case Geometry::GTY_QUAD_MESH     : return Quad4v::max_size()*BVH::maxLeafBlocks;
+        case Geometry::GTY_USER_GEOMETRY : return clamp(size_t(scene->device->object_accel_max_leaf_size),size_t(1),size_t(BVH::maxLeafBlocks));
+        case Geometry::GTY_INSTANCE_CHEAP: return 1;
+        default                          : return Curve4i::max_size();
+        }
+      }
+
+      void build()
+      {
+        const Geometry::GTypeMask gtype = Geometry::GTypeMask(Geometry::MTY_TRIANGLE_MESH | Geometry::MTY_QUAD_MESH | Geometry::MTY_CURVES |
+                                                              Geometry::MTY_USER_GEOMETRY | Geometry::MTY_INSTANCE);
+
+        /* skip build for empty scene */
+        const size_t numPrimitives = scene->getNumPrimitives(gtype,false);
+        if (numPrimitives == 0) {
+          bvh->clear();
+          prims.clear();
+          return;
+        }
+
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderMixedSAH");
+
+        /* initialize allocator */
+        const size_t node_bytes = numPrimitives*sizeof(typename BVH::AABBNodeMB)/(4*N);
+        const size_t leaf_bytes = size_t(1.2*Triangle4::blocks(numPrimitives)*sizeof(Triangle4));
+        bvh->alloc.init_estimate(node_bytes+leaf_bytes);
+        settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+        prims.resize(numPrimitives);
+
+        PrimInfo pinfo = createPrimRefArray(scene,gtype,false,numPrimitives,prims,scene->progressInterface);
+
+        /* pinfo might has zero size due to invalid geometry */
+        if (unlikely(pinfo.size() == 0))
+        {
+          bvh->clear();
+          prims.clear();
+          return;
+        }
+
+        auto getKey = [&] (unsigned int geomID) { return MixedLeaf::leafKey(scene,geomID); };
+
+        /* creates a leaf node */
+        auto createLeaf = [&] (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) -> NodeRef
+        {
+          Geometry* geom = scene->get(prims[set.begin()].geomID());
+          switch (geom->getType()) {
+          case Geometry::GTY_TRIANGLE_MESH:
+            return MixedLeaf::createLeaf<Triangle4>(bvh,Geometry::GTY_TRIANGLE_MESH,prims,set,alloc);
+          case Geometry::GTY_QUAD_MESH:
+            return MixedLeaf::createLeaf<Quad4v>(bvh,Geometry::GTY_QUAD_MESH,prims,set,alloc);
+          case Geometry::GTY_USER_GEOMETRY:
+            return MixedLeaf::createLeaf<Object>(bvh,Geometry::GTY_USER_GEOMETRY,prims,set,alloc);
+          case Geometry::GTY_INSTANCE_CHEAP:
+          case Geometry::GTY_INSTANCE_EXPENSIVE:
+            return MixedLeaf::createLeaf<InstancePrimitive>(bvh,Geometry::GTY_INSTANCE_CHEAP,prims,set,alloc);
+          default:
+            if (geom->getTypeMask() & Geometry::MTY_POINTS)
+              return Point4i::createLeaf(bvh,prims,set,alloc);
+            else if (geom->getCurveBasis() == Geometry::GTY_BASIS_LINEAR)
+              return Line4i::createLeaf(bvh,prims,set,alloc);
+            else
+              return Curve4i::createLeaf(bvh,prims,set,alloc);
+          }
+        };
+
+        /* a leaf may only contain primitives of the same key */
+        auto canCreateLeaf = [&] (const PrimRef* prims, const PrimInfoRange& set) -> bool
+        {
+          const unsigned int geomID0 = prims[set.begin()].geomID();
+          if (set.size() > maxLeafSize(scene->get(geomID0)->getType()))
+            return false;
+          const size_t key0 = getKey(geomID0);
+          for (size_t i=set.begin()+1; i<set.end(); i++)
+            if (getKey(prims[i].geomID()) != key0)
+              return false;
+          return true;
+        };
+
+        auto canCreateLeafSplit = [&] (PrimRef* prims, const PrimInfoRange& set, PrimInfoRange& lset, PrimInfoRange& rset)
+        {
+          const size_t key0 = getKey(prims[set.begin()].geomID());
+          for (size_t i=set.begin()+1; i<set.end(); i++) {
+            if (getKey(prims[i].geomID()) != key0) {
+              performTypeSplit(getKey,key0,prims,set,lset,rset);
+              return;
+            }
+          }
+          performFallbackSplit(prims,set,lset,rset);
+        };
+
+        /* call BVH builder */
+        settings.branchingFactor = N;
+        settings.maxDepth = BVH::maxBuildDepthLeaf;
+        NodeRef root = BVHBuilderBinnedSAH::build<NodeRef>
+          (FastAllocator::Create(&bvh->alloc),typename BVH::AABBNode::Create2(),typename BVH::AABBNode::Set3(&bvh->alloc,prims.data()),
+           createLeaf,canCreateLeaf,canCreateLeafSplit,scene->progressInterface,prims.data(),pinfo,settings);
+
+        bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+        bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+
+        /* for static geometries we can do some cleanups */
+        if (scene->isStaticAccel())
+          prims.clear();
+
+        bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+      }
+    };
+
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+
     
 #if defined(EMBREE_GEOMETRY_TRIANGLE)
     Builder* BVH4Triangle4MeshBuilderSAH  (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderSAH<4,Triangle4>((BVH4*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
@@ -457,6 +601,7 @@ namespace embree
     Builder* BVH4Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH4Triangle4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4v>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH4Triangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type,true); }
+    Builder* BVH4Triangle4wSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4w>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
 
     Builder* BVH4QuantizedTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
 #if defined(__AVX__)
@@ -467,11 +612,15 @@ namespace embree
     Builder* BVH8Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,Triangle4>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH8Triangle4vSceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,Triangle4v>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH8Triangle4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type,true); }
+    Builder* BVH8Triangle4wSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,Triangle4w>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH8QuantizedTriangle4iSceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH8QuantizedTriangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,Triangle4>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
 
     
 
+#endif
+#if defined(__AVX512F__)
+    Builder* BVH16Triangle4SceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<16,Triangle4>((BVH16*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
 #endif
 #endif
 
@@ -552,6 +701,8 @@ namespace embree
 #endif
 #endif
 
+    Builder* BVH4MixedSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMixedSAH<4>((BVH4*)bvh,scene); }
+
 #if defined(EMBREE_GEOMETRY_GRID)
     Builder* BVH4GridMeshBuilderSAH  (void* bvh, GridMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderSAHGrid<4>((BVH4*)bvh,mesh,geomID,4,1.0f,4,4,mode); }
     Builder* BVH4GridSceneBuilderSAH (void* bvh, Scene* scene, size_t mode)   { return new BVHNBuilderSAHGrid<4>((BVH4*)bvh,scene,4,1.0f,4,4,mode); } // FIXME: check whether cost factors are correct
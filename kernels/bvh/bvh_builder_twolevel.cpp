@@ -122,7 +122,10 @@ namespace embree
         refs.resize(nextRef);
 
         /* this probably needs some more tuning */
-        const size_t extSize = max(max((size_t)SPLIT_MIN_EXT_SPACE,refs.size()*SPLIT_MEMORY_RESERVE_SCALE),size_t((float)numPrimitives / SPLIT_MEMORY_RESERVE_FACTOR));
+        const size_t blockSize = scene->device->instancing_block_size ? scene->device->instancing_block_size : SPLIT_MEMORY_RESERVE_FACTOR;
+        size_t extSize = max(max((size_t)SPLIT_MIN_EXT_SPACE,refs.size()*SPLIT_MEMORY_RESERVE_SCALE),size_t((float)numPrimitives / blockSize));
+        extSize = max(extSize,scene->device->instancing_open_min);
+        extSize = max(min(extSize,scene->device->instancing_open_max),refs.size());
  
 #if !ENABLE_DIRECT_SAH_MERGE_BUILDER
 
@@ -178,6 +181,12 @@ namespace embree
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
             
             refs.resize(extSize); 
+
+            /* quality metrics of the top-level hierarchy */
+            const bool printQuality = scene->device->verbosity(2);
+            std::atomic<size_t> numTopLevelRefs(0);
+            std::atomic<size_t> topLevelRefSAH(0); // fixed point to accumulate in parallel
+            const float invRootArea = 1.0f/max(halfArea(pinfo.geomBounds),min_rcp_input);
          
             NodeRef root = BVHBuilderBinnedOpenMergeSAH::build<NodeRef,BuildRef>(
               typename BVH::CreateAlloc(bvh),
@@ -186,6 +195,11 @@ namespace embree
               
               [&] (const BuildRef* refs, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef  {
                 assert(range.size() == 1);
+                if (unlikely(printQuality)) {
+                  const BuildRef& ref = refs[range.begin()];
+                  numTopLevelRefs++;
+                  topLevelRefSAH += size_t(1E6f*halfArea(ref.bounds())*invRootArea*ref.cost());
+                }
                 return (NodeRef) refs[range.begin()].node;
               },
               [&] (BuildRef &bref, BuildRef *refs) -> size_t { 
@@ -193,6 +207,12 @@ namespace embree
               },              
               [&] (size_t dn) { bvh->scene->progressMonitor(0); },
               refs.data(),extSize,pinfo,settings);
+
+            if (unlikely(printQuality)) {
+              Lock<MutexSys> lock(g_printMutex);
+              std::cout << "top-level BVH" << N << ": " << pinfo.size() << " refs opened to " << numTopLevelRefs << " refs (" << extSize << " max), ";
+              std::cout << "expected ref cost = " << 1E-6*double(topLevelRefSAH) << std::endl;
+            }
 #else
             NodeRef root = BVHBuilderBinnedSAH::build<NodeRef>(
               typename BVH::CreateAlloc(bvh),
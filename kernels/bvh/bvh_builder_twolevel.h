@@ -7,6 +7,7 @@
 
 #include "bvh_builder_twolevel_internal.h"
 #include "bvh.h"
+#include "bvh_statistics.h"
 #include "../builders/priminfo.h"
 #include "../builders/primrefgen.h"
 
@@ -16,6 +17,7 @@
 #define SPLIT_MEMORY_RESERVE_FACTOR 1000
 #define SPLIT_MEMORY_RESERVE_SCALE 2
 #define SPLIT_MIN_EXT_SPACE 1000
+#define MAX_REF_WEIGHT (1<<20)
 
 namespace embree
 {
@@ -50,9 +52,9 @@ namespace embree
             bounds_area = area(this->bounds());
         }
 
-        /* used by the open/merge bvh builder */
-        __forceinline BuildRef (const BBox3fa& bounds, NodeRef node, const unsigned int geomID, const unsigned int numPrimitives)
-          : PrimRef(bounds,geomID,numPrimitives), node(node)
+        /* used by the open/merge bvh builder, the weight is the SAH cost of the referenced subtree scaled by N */
+        __forceinline BuildRef (const BBox3fa& bounds, NodeRef node, const unsigned int geomID, const unsigned int weight)
+          : PrimRef(bounds,geomID,weight), node(node)
         {
           /* important for relative buildref ordering */
           if (node.isLeaf())
@@ -61,20 +63,29 @@ namespace embree
             bounds_area = area(this->bounds());
         }
 
+        /* weight used for binning */
         __forceinline size_t size() const {
           return primID();
         }
 
+        /* expected cost of traversing the referenced subtree in units of node traversals */
+        __forceinline float cost() const {
+          return float(primID())*(1.0f/float(N));
+        }
+
+        /* converts subtree SAH into a binning weight, such that the block count of the SAH sweep is the cost */
+        static __forceinline unsigned int weight(const float sah) {
+          return (unsigned int) clamp(sah*float(N)+0.5f,1.0f,float(MAX_REF_WEIGHT));
+        }
+
         friend bool operator< (const BuildRef& a, const BuildRef& b) {
           return a.bounds_area < b.bounds_area;
         }
 
         friend __forceinline embree_ostream operator<<(embree_ostream cout, const BuildRef& ref) {
-          return cout << "{ lower = " << ref.lower << ", upper = " << ref.upper << ", center2 = " << ref.center2() << ", geomID = " << ref.geomID() << ", numPrimitives = " << ref.numPrimitives() << ", bounds_area = " << ref.bounds_area << " }";
+          return cout << "{ lower = " << ref.lower << ", upper = " << ref.upper << ", center2 = " << ref.center2() << ", geomID = " << ref.geomID() << ", cost = " << ref.cost() << ", bounds_area = " << ref.bounds_area << " }";
         }
 
-        __forceinline unsigned int numPrimitives() const { return primID(); }
-
       public:
         NodeRef node;
         float bounds_area;
@@ -89,12 +100,23 @@ namespace embree
         }
         NodeRef ref = bref.node;
         unsigned int geomID   = bref.geomID();
-        unsigned int numPrims = max((unsigned int)bref.numPrimitives() / N,(unsigned int)1);
         AABBNode* node = ref.getAABBNode();
+
+        /* the opened node costs one traversal step, the remaining cost
+         * is distributed assuming all children have equal cost */
+        float childArea = 0.0f;
+        for (size_t i=0; i<N; i++) {
+          if (node->child(i) == BVH::emptyNode) continue;
+          childArea += halfArea(node->bounds(i));
+        }
+        const float parentArea = halfArea(bref.bounds());
+        const float childCost = childArea > 0.0f ? (bref.cost()-1.0f)*parentArea/childArea : 1.0f;
+        const unsigned int childWeight = BuildRef::weight(max(childCost,1.0f));
+        
         size_t n = 0;
         for (size_t i=0; i<N; i++) {
           if (node->child(i) == BVH::emptyNode) continue;
-          refs[i] = BuildRef(node->bounds(i),node->child(i),geomID,numPrims);
+          refs[i] = BuildRef(node->bounds(i),node->child(i),geomID,childWeight);
           n++;
         }
         assert(n > 1);
@@ -147,7 +169,7 @@ namespace embree
             
             /* create build primitive */
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
-            topBuilder->refs[topBuilder->nextRef++] = BVHNBuilderTwoLevel::BuildRef(pinfo.geomBounds,node,(unsigned int)objectID_,1);
+            topBuilder->refs[topBuilder->nextRef++] = BVHNBuilderTwoLevel::BuildRef(pinfo.geomBounds,node,(unsigned int)objectID_,BuildRef::weight(1.0f));
 #else
             topBuilder->refs[topBuilder->nextRef++] = BVHNBuilderTwoLevel::BuildRef(pinfo.geomBounds,node);
 #endif
@@ -166,22 +188,29 @@ namespace embree
       public:
         
         RefBuilderLarge (size_t objectID, const Ref<Builder>& builder, RTCBuildQuality quality)
-        : objectID_ (objectID), builder_ (builder), quality_ (quality) {}
+        : objectID_ (objectID), builder_ (builder), quality_ (quality), sah_ (0.0f) {}
 
         void attachBuildRefs (BVHNBuilderTwoLevel* topBuilder)
         {
           BVH* object  = topBuilder->getBVH(objectID_); assert(object);
           
           /* build object if it got modified */
-          if (topBuilder->isGeometryModified(objectID_))
-            builder_->build();
+          if (topBuilder->isGeometryModified(objectID_) || sah_ == 0.0f)
+          {
+            if (topBuilder->isGeometryModified(objectID_))
+              builder_->build();
+
+            /* the SAH cost of the object weights its reference in the top-level build */
+#if ENABLE_DIRECT_SAH_MERGE_BUILDER
+            sah_ = object->getBounds().empty() ? 0.0f : (float) BVHNStatistics<N>(object).sah();
+#endif
+          }
 
           /* create build primitive */
           if (!object->getBounds().empty())
           {
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
-            Mesh* mesh = topBuilder->getMesh(objectID_);
-            topBuilder->refs[topBuilder->nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->getBounds(),object->root,(unsigned int)objectID_,(unsigned int)mesh->size());
+            topBuilder->refs[topBuilder->nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->getBounds(),object->root,(unsigned int)objectID_,BuildRef::weight(sah_));
 #else
             topBuilder->refs[topBuilder->nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->getBounds(),object->root);
 #endif
@@ -196,6 +225,7 @@ namespace embree
         size_t          objectID_;
         Ref<Builder>    builder_;
         RTCBuildQuality quality_;
+        float           sah_;
       };
 
       void setupLargeBuildRefBuilder (size_t objectID, Mesh const * const mesh);
@@ -4,9 +4,11 @@
 #include "bvh_intersector1.h"
 #include "node_intersector1.h"
 #include "bvh_traverser1.h"
+#include "bvh_node_profile.h"
 
 #include "../geometry/intersector_iterators.h"
 #include "../geometry/triangle_intersector.h"
+#include "../geometry/trianglew_intersector.h"
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
@@ -23,6 +25,7 @@
 #include "../geometry/subgrid_intersector.h"
 #include "../geometry/subgrid_mb_intersector.h"
 #include "../geometry/curve_intersector_virtual.h"
+#include "../geometry/mixed_intersector.h"
 
 namespace embree
 {
@@ -87,6 +90,7 @@ namespace embree
           STAT3(normal.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          NODE_PROFILE(if (cur.isAABBNode()) NodeProfile::get().record(cur.getAABBNode()));
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -169,6 +173,7 @@ namespace embree
           STAT3(shadow.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+          NODE_PROFILE(if (cur.isAABBNode()) NodeProfile::get().record(cur.getAABBNode()));
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
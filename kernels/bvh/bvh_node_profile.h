@@ -0,0 +1,81 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "../common/default.h"
+
+/* Macro to record node visits for profile guided node layout */
+#ifdef EMBREE_BVH_NODE_PROFILE
+#  define NODE_PROFILE(x) x
+#else
+#  define NODE_PROFILE(x)
+#endif
+
+namespace embree
+{
+  /*! Counts how often traversal kernels visit BVH nodes. Nodes are
+   *  identified by a hash of the bounds of their children, which
+   *  stays the same when the same geometry gets rebuilt, thus counts
+   *  recorded during a warm-up frame can guide the node layout of a
+   *  subsequent build. Counts of nodes with colliding hashes get
+   *  merged, which only affects the quality of the layout. */
+  class NodeProfile
+  {
+  public:
+
+    static const size_t SIZE = 1 << 20;
+
+    NodeProfile () {
+      clear();
+    }
+
+    static __forceinline NodeProfile& get()
+    {
+      static NodeProfile instance;
+      return instance;
+    }
+
+    void clear()
+    {
+      for (auto& c : counts) c.store(0);
+      recorded.store(false);
+    }
+
+    /*! returns true if any node visit got recorded */
+    __forceinline bool empty() const {
+      return !recorded.load();
+    }
+
+    /*! records a visit of a node */
+    template<typename AABBNode>
+    __forceinline void record(const AABBNode* node)
+    {
+      counts[key(node)].fetch_add(1,std::memory_order_relaxed);
+      if (unlikely(!recorded.load(std::memory_order_relaxed))) recorded.store(true);
+    }
+
+    /*! returns the number of recorded visits of a node */
+    template<typename AABBNode>
+    __forceinline unsigned int count(const AABBNode* node) const {
+      return counts[key(node)].load(std::memory_order_relaxed);
+    }
+
+  private:
+
+    template<typename AABBNode>
+    static __forceinline size_t key(const AABBNode* node)
+    {
+      const unsigned int* bounds = (const unsigned int*) &node->lower_x;
+      const size_t num = 6*sizeof(node->lower_x)/sizeof(unsigned int);
+      unsigned int hash = 2166136261u;
+      for (size_t i=0; i<num; i++)
+        hash = (hash ^ bounds[i]) * 16777619u;
+      return hash & (SIZE-1);
+    }
+
+  private:
+    std::atomic<unsigned int> counts[SIZE];
+    std::atomic<bool> recorded;
+  };
+}
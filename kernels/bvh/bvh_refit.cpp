@@ -31,13 +31,15 @@ namespace embree
 
     template<int N>
     BVHNRefitter<N>::BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds)
-      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0)
+      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0), onlyModifiedLeaves(false)
     {
     }
 
     template<int N>
-    void BVHNRefitter<N>::refit()
+    void BVHNRefitter<N>::refit(bool onlyModifiedLeaves)
     {
+      this->onlyModifiedLeaves = onlyModifiedLeaves;
+
       if (bvh->numPrimitives <= SINGLE_THREAD_THRESHOLD) {
         bvh->bounds = LBBox3fa(recurse_bottom(bvh->root));
       }
@@ -152,6 +154,9 @@ namespace embree
         {
           bounds[i] = BBox3fa(empty);          
         }
+      /* unmodified leaves keep their bounds */
+      else if (onlyModifiedLeaves && node->child(i).isLeaf() && !leafBounds.leafModified(node->child(i)))
+        bounds[i] = node->bounds(i);
       else
         bounds[i] = recurse_bottom(node->child(i));
       
@@ -171,7 +176,42 @@ namespace embree
 
     template<int N, typename Mesh, typename Primitive>
     BVHNRefitT<N,Mesh,Primitive>::BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode)
-      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0) {}
+      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0), modCounter(-1), modifiedPrims(0,0) {}
+
+    /* tests if one of the primitives of a leaf block lies in the range */
+    template<typename Primitive>
+    __forceinline bool primitiveInRange(const Primitive& prim, const range<size_t>& r)
+    {
+      for (size_t i=0; i<Primitive::max_size(); i++) {
+        if (!prim.valid(i)) break;
+        if (size_t(prim.primID(i))-r.begin() < r.size()) return true;
+      }
+      return false;
+    }
+
+    __forceinline bool primitiveInRange(const Object& prim, const range<size_t>& r) {
+      return size_t(prim.primID())-r.begin() < r.size();
+    }
+
+    __forceinline bool primitiveInRange(const InstancePrimitive& prim, const range<size_t>& r) {
+      return !r.empty();
+    }
+
+    __forceinline bool primitiveInRange(const InstanceArrayPrimitive& prim, const range<size_t>& r) {
+      return size_t(prim.primID_)-r.begin() < r.size();
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    bool BVHNRefitT<N,Mesh,Primitive>::leafModified(NodeRef& ref) const
+    {
+      size_t num; char* prim = ref.leaf(num);
+      if (unlikely(ref == BVH::emptyNode)) return false;
+
+      for (size_t i=0; i<num; i++)
+        if (primitiveInRange(((Primitive*)prim)[i],modifiedPrims))
+          return true;
+      return false;
+    }
 
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::clear()
@@ -188,7 +228,12 @@ namespace embree
         builder->build();
       }
       else
-        refitter->refit();
+      {
+        /* only refit the leaves of primitives modified since the last refit */
+        modifiedPrims = mesh->getModifiedPrimRange(modCounter);
+        refitter->refit(modifiedPrims.size() < mesh->size());
+      }
+      modCounter = mesh->getModCounter();
     }
 
     template class BVHNRefitter<4>;
@@ -21,6 +21,7 @@ namespace embree
 
       struct LeafBoundsInterface {
         virtual const BBox3fa leafBounds(NodeRef& ref) const = 0;
+        virtual bool leafModified(NodeRef& ref) const { return true; }
       };
 
     public:
@@ -28,8 +29,8 @@ namespace embree
       /*! Constructor. */
       BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds);
 
-      /*! refits the BVH */
-      void refit();
+      /*! refits the BVH, optionally only the leaves reported as modified */
+      void refit(bool onlyModifiedLeaves = false);
 
     private:
       /* single-threaded subtree extraction based on BVH depth */
@@ -54,6 +55,7 @@ namespace embree
       static const size_t MAX_NUM_SUB_TREES             = (N==4) ? 256 : (N==8) ? 512 : N*N*N; // N ^ MAX_SUB_TREE_EXTRACTION_DEPTH
       size_t numSubTrees;
       NodeRef subTrees[MAX_NUM_SUB_TREES];
+      bool onlyModifiedLeaves;
     };
 
     template<int N, typename Mesh, typename Primitive>
@@ -83,6 +85,8 @@ namespace embree
             bounds.extend(((Primitive*)prim)[i].update(mesh));
         return bounds;
       }
+
+      virtual bool leafModified (NodeRef& ref) const;
       
     private:
       BVH* bvh;
@@ -90,6 +94,8 @@ namespace embree
       std::unique_ptr<BVHNRefitter<N>> refitter;
       Mesh* mesh;
       unsigned int topologyVersion;
+      unsigned int modCounter;      //!< modification counter of the mesh at the last build or refit
+      range<size_t> modifiedPrims;  //!< primitives modified since the last build or refit
     };
   }
 }
@@ -155,6 +155,13 @@ namespace embree
     return s;
   } 
 
+#if defined(__AVX512F__)
+  template class BVHNStatistics<16>;
+#endif
+
+/* the AVX512 library only instantiates the BVH16 */
+#if !defined(__AVX512F__) || defined(EMBREE_LOWEST_ISA)
+
 #if defined(__AVX__)
   template class BVHNStatistics<8>;
 #endif
@@ -162,4 +169,6 @@ namespace embree
 #if !defined(__AVX__) || (!defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)) || defined(__aarch64__)
   template class BVHNStatistics<4>;
 #endif
+
+#endif
 }
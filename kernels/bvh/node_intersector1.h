@@ -530,6 +530,27 @@ namespace embree
       return mask;
     }
 
+#endif
+
+#if defined(__AVX512F__)
+
+    template<>
+      __forceinline size_t intersectNode<16>(const typename BVH16::AABBNode* node, const TravRay<16,false>& ray, vfloat16& dist)
+    {
+      const vfloat16 tNearX = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearX)), ray.rdir.x, ray.org_rdir.x);
+      const vfloat16 tNearY = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearY)), ray.rdir.y, ray.org_rdir.y);
+      const vfloat16 tNearZ = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearZ)), ray.rdir.z, ray.org_rdir.z);
+      const vfloat16 tFarX  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farX )), ray.rdir.x, ray.org_rdir.x);
+      const vfloat16 tFarY  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farY )), ray.rdir.y, ray.org_rdir.y);
+      const vfloat16 tFarZ  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farZ )), ray.rdir.z, ray.org_rdir.z);
+      const vfloat16 tNear = maxi(tNearX,tNearY,tNearZ,ray.tnear);
+      const vfloat16 tFar  = mini(tFarX ,tFarY ,tFarZ ,ray.tfar);
+      const vbool16 vmask = asInt(tNear) <= asInt(tFar);
+      const size_t mask = movemask(vmask);
+      dist = tNear;
+      return mask;
+    }
+
 #endif
 
     //////////////////////////////////////////////////////////////////////////////////////
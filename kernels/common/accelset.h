@@ -142,9 +142,15 @@ namespace embree
   public:
 
       /*! Intersects a single ray with the scene. */
-      __forceinline bool intersect (RayHit& ray, unsigned int geomID, unsigned int primID, RayQueryContext* context) 
+      __forceinline bool intersect (RayHit& ray, unsigned int geomID, unsigned int primID, RayQueryContext* context) {
+        return intersect(ray,geomID,&primID,1,context);
+      }
+
+      /*! Intersects a single ray with primCount primitives of the scene using a single callback invocation. */
+      __forceinline bool intersect (RayHit& ray, unsigned int geomID, const unsigned int* primIDs, unsigned int primCount, RayQueryContext* context) 
       {
-        assert(primID < size());
+        assert(primCount > 0);
+        assert(primIDs[0] < size());
         
         int mask = -1;
         IntersectFunctionNArguments args;
@@ -154,7 +160,9 @@ namespace embree
         args.rayhit = (RTCRayHitN*)&ray;
         args.N = 1;
         args.geomID = geomID;
-        args.primID = primID;
+        args.primID = primIDs[0];
+        args.primIDs = primIDs;
+        args.primCount = primCount;
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = context->args;
@@ -172,9 +180,15 @@ namespace embree
       }
 
       /*! Tests if single ray is occluded by the scene. */
-      __forceinline bool occluded (Ray& ray, unsigned int geomID, unsigned int primID, RayQueryContext* context)
+      __forceinline bool occluded (Ray& ray, unsigned int geomID, unsigned int primID, RayQueryContext* context) {
+        return occluded(ray,geomID,&primID,1,context);
+      }
+
+      /*! Tests if single ray is occluded by primCount primitives of the scene using a single callback invocation. */
+      __forceinline bool occluded (Ray& ray, unsigned int geomID, const unsigned int* primIDs, unsigned int primCount, RayQueryContext* context)
       {
-        assert(primID < size());
+        assert(primCount > 0);
+        assert(primIDs[0] < size());
 
         int mask = -1;
         OccludedFunctionNArguments args;
@@ -184,7 +198,9 @@ namespace embree
         args.ray = (RTCRayN*)&ray;
         args.N = 1;
         args.geomID = geomID;
-        args.primID = primID;
+        args.primID = primIDs[0];
+        args.primIDs = primIDs;
+        args.primCount = primCount;
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = context->args;
@@ -215,6 +231,8 @@ namespace embree
         args.N = 1;
         args.geomID = geomID;
         args.primID = primID;
+        args.primIDs = &args.primID;
+        args.primCount = 1;
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = nullptr;
@@ -252,6 +270,8 @@ namespace embree
         args.N = 1;
         args.geomID = geomID;
         args.primID = primID;
+        args.primIDs = &args.primID;
+        args.primCount = 1;
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = nullptr;
@@ -290,6 +310,8 @@ namespace embree
         args.N = K;
         args.geomID = geomID;
         args.primID = primID;
+        args.primIDs = &args.primID;
+        args.primCount = 1;
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = context->args;
@@ -319,6 +341,8 @@ namespace embree
         args.N = K;
         args.geomID = geomID;
         args.primID = primID;
+        args.primIDs = &args.primID;
+        args.primCount = 1;
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = context->args;
@@ -336,6 +360,7 @@ namespace embree
     public:
       RTCBoundsFunction boundsFunc;
       IntersectorN intersectorN;
+      bool batchedCallbacks; //!< invoke callbacks once for all primitives of a leaf
   };
   
 #define DEFINE_SET_INTERSECTORN(symbol,intersector)                     \
@@ -423,6 +423,9 @@ namespace embree
       //initGrowSizeAndNumSlots(bytesEstimate,false);
       initGrowSizeAndNumSlots(bytesEstimate,false);
 
+      /* small builds allocate all memory with a single block */
+      if (bytesEstimate > 0 && bytesEstimate <= maxAllocationSize)
+        freeBlocks = Block::create(device,useUSM,bytesEstimate,bytesEstimate,nullptr,atype);
     }
 
     /*! frees state not required after build */
@@ -760,6 +763,12 @@ namespace embree
           bytesReserve  = ((bytesReserve +PAGE_SIZE-1) & ~(PAGE_SIZE-1));
         }
 
+        /* reuse a block the device kept from an earlier build */
+        if (device && device->alloc_pool_size && !useUSM) {
+          if (Block* block = reuse(device,bytesAllocate,bytesReserve,next,atype))
+            return block;
+        }
+
         /* either use alignedMalloc or os_malloc */
         void *ptr = nullptr;
         if (atype == ALIGNED_MALLOC)
@@ -799,6 +808,31 @@ namespace embree
         return NULL;
       }
 
+      /*! takes a block of fitting size from the block pool of the device, sizes include the block header */
+      static Block* reuse(Device* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype)
+      {
+        const size_t sizeof_Header = offsetof(Block,data[0]);
+        const bool os = atype == EMBREE_OS_MALLOC;
+        const size_t bytesRequired = os ? bytesReserve : bytesAllocate;
+
+        size_t bytes = 0; bool huge_pages = false;
+        void* ptr = device->blockPool.get(os,bytesRequired,2*bytesRequired,bytes,huge_pages);
+        if (ptr == nullptr) return nullptr;
+
+        /* account the block like a new allocation, the memory monitor may cancel the build */
+        try {
+          if (os) device->memoryMonitor(bytesAllocate,false);
+          else    device->memoryMonitor(bytes+maxAlignment,false);
+        }
+        catch (...) {
+          device->blockPool.put(ptr,bytes,os,huge_pages,std::numeric_limits<size_t>::max());
+          throw;
+        }
+
+        if (os) return new (ptr) Block(EMBREE_OS_MALLOC,bytesAllocate-sizeof_Header,bytes-sizeof_Header,next,0,huge_pages);
+        else    return new (ptr) Block(ALIGNED_MALLOC,bytes-sizeof_Header,bytes-sizeof_Header,next,maxAlignment);
+      }
+
       Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false)
       : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), huge_pages(huge_pages)
       {
@@ -830,6 +864,15 @@ namespace embree
         const size_t sizeof_Header = offsetof(Block,data[0]);
         const ssize_t sizeof_Alloced = wasted+sizeof_Header+getBlockAllocatedBytes();
 
+        /* keep the block in the block pool of the device for later builds */
+        if (device && device->alloc_pool_size && !useUSM && atype != SHARED)
+        {
+          if (device->blockPool.put(this,sizeof_Header+reserveEnd,atype == EMBREE_OS_MALLOC,huge_pages,device->alloc_pool_size)) {
+            device->memoryMonitor(-sizeof_Alloced,true);
+            return;
+          }
+        }
+
         if (atype == ALIGNED_MALLOC) {
           blockAlignedFree(device, useUSM, this);
           if (device) device->memoryMonitor(-sizeof_Alloced,true);
@@ -266,6 +266,7 @@ namespace embree
     __forceinline const Vec3fa operator [](size_t i) const
     {
       assert(i<num);
+      if (unlikely(isCompressed())) return decode(i);
       return Vec3fa(vfloat4::loadu((float*)(ptr_ofs + i*stride)));
     }
     
@@ -273,8 +274,34 @@ namespace embree
     __forceinline void store(size_t i, const Vec3fa& v)
     {
       assert(i<num);
+      assert(!isCompressed());
       vfloat4::storeu((float*)(ptr_ofs + i*stride), (vfloat4)v);
     }
+
+    /*! decodes the ith element of a half precision or quantized buffer */
+    __forceinline const Vec3fa decode(size_t i) const
+    {
+      const char* ptr = ptr_ofs + i*stride;
+      if (format == RTC_FORMAT_HALF3)
+        return Vec3fa(vfloat4::load_hf16(ptr));
+      const vfloat4 q(vint4(*(short*)(ptr+0),*(short*)(ptr+2),*(short*)(ptr+4),0));
+      return Vec3fa(madd(q,vfloat4(quant_scale.x,quant_scale.y,quant_scale.z,0.0f),vfloat4(quant_offset.x,quant_offset.y,quant_offset.z,0.0f)));
+    }
 #endif
+
+    /*! returns true if elements are stored in half precision or quantized */
+    __forceinline bool isCompressed() const {
+      return format == RTC_FORMAT_HALF3 || format == RTC_FORMAT_SHORT3;
+    }
+
+    /*! sets scale and offset to decode quantized elements */
+    __forceinline void setQuantization(const Vec3f& scale, const Vec3f& offset) {
+      quant_scale = scale;
+      quant_offset = offset;
+    }
+
+  public:
+    Vec3f quant_scale = Vec3f(1.0f);   //!< scale of quantized elements
+    Vec3f quant_offset = Vec3f(0.0f);  //!< offset of quantized elements
   };
 }
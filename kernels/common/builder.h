@@ -16,6 +16,9 @@ namespace embree
 
     static const size_t DEFAULT_SINGLE_THREAD_THRESHOLD = 1024;
 
+    /*! scenes below this number of primitives get built sequentially on the committing thread */
+    static const size_t SMALL_SCENE_THRESHOLD = 4096;
+
     /*! initiates the hierarchy builder */
     virtual void build() = 0;
 
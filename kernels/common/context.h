@@ -59,6 +59,9 @@ namespace embree
     Scene* scene = nullptr;
     RTCRayQueryContext* user = nullptr;
     RTCIntersectArguments* args = nullptr;
+    RTCRayMultiHit* multihit = nullptr; // sorted hit buffer of rtcIntersectMultiHit queries
+    float* transmittance = nullptr;     // per ray transmittance of transmittance queries
+    float minTransmittance = 0.0f;      // transmittance below which rays are occluded
   };
 
   template<int M, typename Geometry>
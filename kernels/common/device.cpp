@@ -21,6 +21,7 @@
 
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
+#include "../bvh/bvh16_factory.h"
 
 #include "../../common/sys/alloc.h"
 
@@ -131,16 +132,89 @@ namespace embree
     bvh8_factory = make_unique(new BVH8Factory(enabled_builder_cpu_features, enabled_cpu_features));
 #endif
 
+#if defined(EMBREE_TARGET_SIMD16)
+    bvh16_factory = make_unique(new BVH16Factory(enabled_builder_cpu_features, enabled_cpu_features));
+#endif
+
     /* setup tasking system */
     initTaskingSystem(numThreads);
   }
 
   Device::~Device ()
   {
+    if (State::verbosity(2) && alloc_pool_size)
+      blockPool.print();
+    blockPool.clear();
+
     setCacheSize(0);
     exitTaskingSystem();
   }
 
+  void* Device::BlockPool::get(bool os, size_t minBytes, size_t maxBytes, size_t& bytes_o, bool& hugePages_o)
+  {
+    Lock<MutexSys> lock(mutex);
+
+    size_t best = entries.size();
+    for (size_t i=0; i<entries.size(); i++)
+    {
+      const Entry& e = entries[i];
+      if (e.os != os || e.bytes < minBytes || e.bytes > maxBytes) continue;
+      if (best == entries.size() || e.bytes < entries[best].bytes) best = i;
+    }
+    if (best == entries.size()) {
+      numAllocated++;
+      return nullptr;
+    }
+
+    const Entry e = entries[best];
+    entries[best] = entries.back();
+    entries.pop_back();
+    bytes -= e.bytes;
+    numReused++;
+    bytesReused += e.bytes;
+
+    bytes_o = e.bytes;
+    hugePages_o = e.hugePages;
+    return e.ptr;
+  }
+
+  bool Device::BlockPool::put(void* ptr, size_t bytes_i, bool os, bool hugePages, size_t maxPoolBytes)
+  {
+    Lock<MutexSys> lock(mutex);
+    if (bytes+bytes_i > maxPoolBytes) {
+      numReleased++;
+      return false;
+    }
+
+    Entry e;
+    e.ptr = ptr;
+    e.bytes = bytes_i;
+    e.os = os;
+    e.hugePages = hugePages;
+    entries.push_back(e);
+    bytes += bytes_i;
+    numRetained++;
+    return true;
+  }
+
+  void Device::BlockPool::clear()
+  {
+    Lock<MutexSys> lock(mutex);
+    for (const Entry& e : entries) {
+      if (e.os) os_free(e.ptr,e.bytes,e.hugePages);
+      else      alignedFree(e.ptr);
+    }
+    entries.clear();
+    bytes = 0;
+  }
+
+  void Device::BlockPool::print() const
+  {
+    std::cout << "allocator block pool statistics:" << std::endl;
+    std::cout << "  reused blocks = " << numReused << " (" << 1E-6*double(bytesReused) << " MB), allocated blocks = " << numAllocated << std::endl;
+    std::cout << "  retained blocks = " << numRetained << ", released blocks = " << numReleased << ", pool size = " << 1E-6*double(bytes) << " MB" << std::endl;
+  }
+
   std::string getEnabledTargets()
   {
     std::string v;
@@ -369,8 +443,15 @@ namespace embree
     /* create task scheduler */
     size_t maxNumThreads = getMaxNumThreads();
     TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads);
+#if defined(TASKING_INTERNAL)
+    TaskScheduler::IdlePolicy policy;
+    policy.spinRounds = State::tasking_spin_rounds;
+    policy.yieldRounds = State::tasking_yield_rounds;
+    policy.park = State::tasking_park;
+    TaskScheduler::setIdlePolicy(policy);
+#endif
 #if USE_TASK_ARENA
-    const size_t nThreads = min(maxNumThreads,TaskScheduler::threadCount());
+    const size_t nThreads = min(maxNumThreads,TaskScheduler::tbbThreadCount());
     const size_t uThreads = min(max(numUserThreads,(size_t)1),nThreads);
     arena->arena = make_unique(new tbb::task_arena((int)nThreads,(unsigned int)uThreads));
 #endif
@@ -381,6 +462,13 @@ namespace embree
     Lock<MutexSys> lock(g_mutex);
     g_num_threads_map.erase(this);
 
+#if defined(TASKING_INTERNAL)
+    if (State::verbosity(2)) {
+      TaskScheduler::statistics().print();
+      TaskScheduler::statistics().reset();
+    }
+#endif
+
     /* terminate tasking system */
     if (g_num_threads_map.size() == 0) {
       TaskScheduler::destroy();
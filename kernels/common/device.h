@@ -11,6 +11,7 @@ namespace embree
 {
   class BVH4Factory;
   class BVH8Factory;
+  class BVH16Factory;
   struct TaskArena;
 
   class Device : public State, public MemoryMonitorInterface
@@ -113,6 +114,45 @@ namespace embree
     /*! buffer deallocation */
     virtual void free(void* ptr);
 
+    /*! memory blocks released by the BVH allocators of all scenes, kept for reuse by later builds */
+    struct BlockPool
+    {
+      struct Entry
+      {
+        void* ptr;        //!< start of the block
+        size_t bytes;     //!< size of the block
+        bool os;          //!< block got allocated with os_malloc
+        bool hugePages;   //!< block uses huge pages
+      };
+
+      BlockPool ()
+        : bytes(0), numReused(0), numAllocated(0), numRetained(0), numReleased(0), bytesReused(0) {}
+
+      /*! removes the smallest block of the given type with a size in [minBytes,maxBytes] from the pool, returns nullptr if there is none */
+      void* get(bool os, size_t minBytes, size_t maxBytes, size_t& bytes, bool& hugePages);
+
+      /*! adds a block to the pool, returns false if the pool would grow beyond maxPoolBytes */
+      bool put(void* ptr, size_t bytes, bool os, bool hugePages, size_t maxPoolBytes);
+
+      /*! frees all blocks of the pool */
+      void clear();
+
+      /*! prints reuse statistics */
+      void print() const;
+
+    private:
+      MutexSys mutex;
+      std::vector<Entry> entries;
+      size_t bytes;          //!< total size of all blocks in the pool
+      size_t numReused;      //!< number of block allocations served from the pool
+      size_t numAllocated;   //!< number of block allocations the pool could not serve
+      size_t numRetained;    //!< number of freed blocks kept in the pool
+      size_t numReleased;    //!< number of freed blocks released as the pool was full
+      size_t bytesReused;    //!< total size of all reused blocks
+    };
+
+    BlockPool blockPool;
+
   private:
 
     /*! initializes the tasking system */
@@ -139,6 +179,9 @@ namespace embree
     std::unique_ptr<BVH4Factory> bvh4_factory;
 #if defined(EMBREE_TARGET_SIMD8)
     std::unique_ptr<BVH8Factory> bvh8_factory;
+#endif
+#if defined(EMBREE_TARGET_SIMD16)
+    std::unique_ptr<BVH16Factory> bvh16_factory;
 #endif
   };
 
@@ -46,6 +46,7 @@ namespace embree
     : device(device), userPtr(nullptr),
       numPrimitives(numPrimitives), numTimeSteps(unsigned(numTimeSteps)), fnumTimeSegments(float(numTimeSteps-1)), time_range(0.0f,1.0f),
       mask(1),
+      opacity(1.0f), opacityBuffer(nullptr),
       gtype(gtype),
       gsubtype(GTY_SUBTYPE_DEFAULT),
       quality(RTC_BUILD_QUALITY_MEDIUM),
@@ -98,11 +99,25 @@ namespace embree
   {
     ++modCounter_; // FIXME: required?
     state = (unsigned)State::MODIFIED;
+    pendingModifiedPrims_ = range<size_t>(0,std::numeric_limits<size_t>::max());
+  }
+
+  void Geometry::update(const range<size_t>& prims)
+  {
+    ++modCounter_;
+    state = (unsigned)State::MODIFIED;
+    pendingModifiedPrims_ = pendingModifiedPrims_.merge(prims);
   }
   
   void Geometry::commit() 
   {
+    /* the modified primitives are relative to the previous commit */
+    prevCommitModCounter_ = commitModCounter_;
+    modifiedPrims_ = pendingModifiedPrims_;
+    pendingModifiedPrims_ = range<size_t>(0,0);
+
     ++modCounter_;
+    commitModCounter_ = modCounter_;
     state = (unsigned)State::COMMITTED;
   }
 
@@ -155,6 +170,24 @@ namespace embree
     occlusionFilterN = filter;
   }
   
+  void Geometry::setOpacity (float opacity_in)
+  {
+    if (!(getTypeMask() & (MTY_TRIANGLE_MESH | MTY_QUAD_MESH | MTY_CURVES | MTY_SUBDIV_MESH | MTY_GRID_MESH)))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"opacity not supported for this geometry"); 
+    if (!(opacity_in >= 0.0f && opacity_in <= 1.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"opacity has to be in [0,1] range");
+
+    opacity = opacity_in;
+  }
+
+  void Geometry::setOpacityBuffer (const float* opacity_in)
+  {
+    if (!(getTypeMask() & (MTY_TRIANGLE_MESH | MTY_QUAD_MESH | MTY_CURVES | MTY_SUBDIV_MESH | MTY_GRID_MESH)))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"opacity not supported for this geometry"); 
+
+    opacityBuffer = opacity_in;
+  }
+
   void Geometry::setPointQueryFunction (RTCPointQueryFunction func) 
   {
     pointQueryFunc = func;
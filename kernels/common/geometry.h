@@ -314,6 +314,11 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! sets scale and offset of quantized vertex positions */
+    virtual void setVertexQuantization (const Vec3fa& scale, const Vec3fa& offset) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! sets number of topologies */
     virtual void setTopologyCount (unsigned int N) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -355,6 +360,9 @@ namespace embree
 
     /*! Update geometry. */
     void update();
+
+    /*! Update geometry, only the specified range of primitives got modified. */
+    void update(const range<size_t>& prims);
     
     /*! commit of geometry */
     virtual void commit();
@@ -363,6 +371,18 @@ namespace embree
     virtual void updateBuffer(RTCBufferType type, unsigned int slot) {
       update(); // update everything for geometries not supporting this call
     }
+
+    /*! Update range [begin,end) of items of a geometry buffer. */
+    virtual void updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end) {
+      updateBuffer(type,slot); // update entire buffer for geometries not supporting this call
+    }
+
+    /*! Returns the primitives modified since the commit the specified modification counter was taken from. */
+    __forceinline range<size_t> getModifiedPrimRange(unsigned int modCounter) const
+    {
+      if (modCounter != prevCommitModCounter_) return range<size_t>(0,numPrimitives);
+      return modifiedPrims_.intersect(range<size_t>(0,numPrimitives));
+    }
     
     /*! Disable geometry. */
     virtual void disable();
@@ -479,6 +499,12 @@ namespace embree
     /*! Set occlusion filter function for ray packets of size N. */
     virtual void setOcclusionFilterFunctionN (RTCFilterFunctionN filterN);
 
+    /*! Sets opacity of all primitives used by transmittance queries. */
+    void setOpacity (float opacity);
+
+    /*! Sets shared buffer of per primitive opacities used by transmittance queries. */
+    void setOpacityBuffer (const float* opacity);
+
     /* Enables argument version of intersection or occlusion filter function. */
     virtual void enableFilterFunctionFromArguments (bool enable) {
       argumentFilterEnabled = enable;
@@ -497,6 +523,10 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
     }
 
+    /*! Appends the scenes instanced by this geometry */
+    virtual void getInstancedScenes(std::vector<Scene*>& scenes) const {
+    }
+
     /*! Sets transformation of the instance */
     virtual void setTransform(const AffineSpace3fa& transform, unsigned int timeStep) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -534,6 +564,11 @@ namespace embree
     virtual void setOccludedFunctionN (RTCOccludedFunctionN occluded) { 
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
+
+    /*! Enables batched intersect and occluded callbacks for all primitives of a leaf. */
+    virtual void enableBatchedCallbacks (bool enable) { 
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
     
     /*! Set point query function. */
     void setPointQueryFunction(RTCPointQueryFunction func);
@@ -634,6 +669,12 @@ namespace embree
     __forceinline bool hasIntersectionFilter() const { return intersectionFilterN != nullptr; }
     __forceinline bool hasOcclusionFilter() const { return occlusionFilterN != nullptr; }
 
+    /*! returns true if hits only attenuate rays of transmittance queries */
+    __forceinline bool isTransparent() const { return opacity < 1.0f || opacityBuffer != nullptr; }
+
+    /*! returns the opacity of some primitive */
+    __forceinline float getOpacity(unsigned int primID) const { return opacityBuffer ? opacityBuffer[primID] : opacity; }
+
   public:
     Device* device;             //!< device this geometry belongs to
 
@@ -645,7 +686,13 @@ namespace embree
     BBox1f time_range;          //!< motion blur time range
     
     unsigned int mask;             //!< for masking out geometry
+    float opacity;                 //!< opacity of all primitives for transmittance queries
+    const float* opacityBuffer;    //!< optional per primitive opacities for transmittance queries
     unsigned int modCounter_ = 1; //!< counter for every modification - used to rebuild scenes when geo is modified
+    unsigned int commitModCounter_ = 0;     //!< modification counter of the last commit
+    unsigned int prevCommitModCounter_ = 0; //!< modification counter of the commit before the last commit
+    range<size_t> modifiedPrims_ = range<size_t>(0,0);                                       //!< primitives modified between the last two commits
+    range<size_t> pendingModifiedPrims_ = range<size_t>(0,std::numeric_limits<size_t>::max()); //!< primitives modified since the last commit
 
     struct {
       GType gtype : 8;                //!< geometry type
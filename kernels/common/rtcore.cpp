@@ -9,6 +9,7 @@
 #include "context.h"
 #include "../geometry/filter.h"
 #include "../../include/embree4/rtcore_ray.h"
+#include "../../common/tasking/taskscheduler.h"
 using namespace embree;
 
 RTC_NAMESPACE_BEGIN;
@@ -157,6 +158,28 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END(device);
   }
 
+  RTC_API void rtcSetDeviceTaskingFunctions(RTCDevice hdevice, const RTCTaskingFunctions* functions)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetDeviceTaskingFunctions);
+    RTC_VERIFY_HANDLE(hdevice);
+    RTC_ENTER_DEVICE(hdevice);
+    if (functions == nullptr) {
+      ExternalTaskScheduler::set(nullptr);
+      return;
+    }
+    if (functions->parallelFor == nullptr || functions->threadIndex == nullptr || functions->threadCount == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"incomplete tasking functions");
+    ExternalTaskScheduler::Functions f;
+    f.parallelFor = functions->parallelFor;
+    f.threadIndex = functions->threadIndex;
+    f.threadCount = functions->threadCount;
+    f.userPtr     = functions->userPtr;
+    ExternalTaskScheduler::set(&f);
+    RTC_CATCH_END(device);
+  }
+
   RTC_API RTCBuffer rtcNewBuffer(RTCDevice hdevice, size_t byteSize)
   {
     RTC_CATCH_BEGIN;
@@ -265,6 +288,32 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcSetSceneBuildThreadCount (RTCScene hscene, unsigned int threadCount) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneBuildThreadCount);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+    scene->setBuildThreadCount(threadCount);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcSetSceneBuildPriority (RTCScene hscene, RTCBuildPriority priority) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneBuildPriority);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+    if (priority != RTC_BUILD_PRIORITY_LOW &&
+        priority != RTC_BUILD_PRIORITY_NORMAL &&
+        priority != RTC_BUILD_PRIORITY_HIGH)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid build priority");
+    scene->setBuildPriority(priority);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcSetSceneFlags (RTCScene hscene, RTCSceneFlags flags) 
   {
     Scene* scene = (Scene*) hscene;
@@ -317,6 +366,23 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcCommitScenes (RTCScene* hscenes, size_t numScenes) 
+  {
+    Scene** scenes = (Scene**) hscenes;
+    Scene* scene = numScenes ? scenes[0] : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCommitScenes);
+    if (numScenes == 0) return;
+    for (size_t i=0; i<numScenes; i++) {
+      RTC_VERIFY_HANDLE(hscenes[i]);
+      if (scenes[i]->device != scene->device)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"scenes belong to different devices");
+    }
+    RTC_ENTER_DEVICE(hscenes[0]);
+    Scene::commitScenes(scenes,numScenes);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcGetSceneBounds(RTCScene hscene, RTCBounds* bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -552,6 +618,45 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcIntersectMultiHit (RTCScene hscene, RTCRayMultiHit* rayhit, RTCIntersectArguments* args)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectMultiHit);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
+#endif
+    if (rayhit->maxHitCount == 0 || rayhit->maxHitCount > RTC_MAX_MULTI_HIT_COUNT)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid maximum hit count");
+    STAT3(normal.travs,1,1,1);
+
+    RTCIntersectArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitIntersectArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+    context.multihit = rayhit;
+
+    /* the epilogs insert all hits into the hit buffer and shorten the
+     * traced copy of the ray once the buffer is full */
+    RTCRayHit ray;
+    ray.ray = rayhit->ray;
+    ray.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+    rayhit->hitCount = 0;
+    scene->intersectors.intersect(ray,&context);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcForwardIntersect1 (const RTCIntersectFunctionNArguments* args, RTCScene hscene, RTCRay* iray_, unsigned int instID)
   {
     rtcForwardIntersect1Ex(args, hscene, iray_, instID, 0);
@@ -1132,6 +1237,122 @@ RTC_NAMESPACE_BEGIN;
     rtcForwardOccludedN<RTCRay16,16>(valid, args, hscene, iray, instID, instPrimID);
     RTC_CATCH_END2(scene);
   }
+
+  RTC_API void rtcTransmittance1 (RTCScene hscene, RTCRay* ray, float* transmittance, float minTransmittance, RTCOccludedArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcTransmittance1);
+    STAT3(shadow.travs,1,1,1);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)ray) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
+#endif
+
+    RTCOccludedArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitOccludedArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+    context.transmittance = transmittance;
+    context.minTransmittance = minTransmittance;
+    
+    scene->intersectors.occluded(*ray,&context);
+    RTC_CATCH_END2(scene);
+  }
+
+  template<typename RTCRayT, int N>
+  __forceinline void rtcTransmittanceN (const int* valid, RTCScene hscene, RTCRayT* ray, float* transmittance, float minTransmittance, RTCOccludedArguments* args, bool packets)
+  {
+    Scene* scene = (Scene*) hscene;
+    STAT(size_t cnt=0; for (size_t i=0; i<N; i++) cnt += ((int*)valid)[i] == -1;);
+    STAT3(shadow.travs,cnt,cnt,cnt);
+
+    RTCOccludedArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitOccludedArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+    context.minTransmittance = minTransmittance;
+
+    if (likely(packets)) {
+      context.transmittance = transmittance;
+      scene->intersectors.occluded(valid,*ray,&context);
+    }
+
+    else {
+      RayHitK<N>* rayN = (RayHitK<N>*) ray;
+      for (size_t i=0; i<N; i++) {
+        if (!valid[i]) continue;
+        RayHit ray1; rayN->get(i,ray1);
+        context.transmittance = &transmittance[i];
+        scene->intersectors.occluded((RTCRay&)ray1,&context);
+        rayN->set(i,ray1);
+      }
+    }
+  }
+
+  RTC_API void rtcTransmittance4 (const int* valid, RTCScene hscene, RTCRay4* ray, float* transmittance, float minTransmittance, RTCOccludedArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcTransmittance4);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
+    if (((size_t)ray)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
+#endif
+    rtcTransmittanceN<RTCRay4,4>(valid,hscene,ray,transmittance,minTransmittance,args,scene->intersectors.intersector4);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcTransmittance8 (const int* valid, RTCScene hscene, RTCRay8* ray, float* transmittance, float minTransmittance, RTCOccludedArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcTransmittance8);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
+    if (((size_t)ray)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 32 bytes");   
+#endif
+    rtcTransmittanceN<RTCRay8,8>(valid,hscene,ray,transmittance,minTransmittance,args,scene->intersectors.intersector8);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcTransmittance16 (const int* valid, RTCScene hscene, RTCRay16* ray, float* transmittance, float minTransmittance, RTCOccludedArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcTransmittance16);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
+    if (((size_t)ray)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 64 bytes");   
+#endif
+    rtcTransmittanceN<RTCRay16,16>(valid,hscene,ray,transmittance,minTransmittance,args,scene->intersectors.intersector16);
+    RTC_CATCH_END2(scene);
+  }
   
   RTC_API void rtcRetainScene (RTCScene hscene) 
   {
@@ -1552,6 +1773,19 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryVertexQuantization(RTCGeometry hgeometry, const float* scale, const float* offset)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryVertexQuantization);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (scale == nullptr || offset == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid quantization scale or offset");
+    geometry->setVertexQuantization(Vec3fa(scale[0],scale[1],scale[2]),Vec3fa(offset[0],offset[1],offset[2]));
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryTopologyCount(RTCGeometry hgeometry, unsigned int N)
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1720,6 +1954,17 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcUpdateGeometryBufferRange (RTCGeometry hgeometry, RTCBufferType type, unsigned int slot, size_t itemOffset, size_t itemCount) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcUpdateGeometryBufferRange);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->updateBufferRange(type, slot, itemOffset, itemOffset+itemCount);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcDisableGeometry (RTCGeometry hgeometry) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1890,6 +2135,17 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryEnableBatchedCallbacks (RTCGeometry hgeometry, bool enable) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryEnableBatchedCallbacks);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->enableBatchedCallbacks(enable);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryIntersectFilterFunction (RTCGeometry hgeometry, RTCFilterFunctionN filter) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1912,6 +2168,28 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryOpacity (RTCGeometry hgeometry, float opacity) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryOpacity);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->setOpacity(opacity);
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcSetGeometryOpacityBuffer (RTCGeometry hgeometry, const float* opacity) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryOpacityBuffer);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->setOpacityBuffer(opacity);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryEnableFilterFunctionFromArguments (RTCGeometry hgeometry, bool enable) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
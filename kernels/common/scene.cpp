@@ -7,6 +7,7 @@
 
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
+#include "../bvh/bvh16_factory.h"
 
 #include "../../common/algorithms/parallel_reduce.h"
 
@@ -30,6 +31,51 @@ namespace embree
 #elif defined(TASKING_PPL)
     concurrency::task_group group;
 #endif
+
+#if USE_TASK_ARENA
+    /*! arena for builds with limited thread count or non-default priority */
+    MutexSys arenaMutex;
+    std::shared_ptr<tbb::task_arena> arena;
+    unsigned int arenaThreads = 0;
+    RTCBuildPriority arenaPriority = RTC_BUILD_PRIORITY_NORMAL;
+
+    std::shared_ptr<tbb::task_arena> getArena()
+    {
+      Lock<MutexSys> lock(arenaMutex);
+      return arena;
+    }
+
+    /*! creates a new arena if the build settings changed */
+    void updateArena(unsigned int threads, RTCBuildPriority priority)
+    {
+      Lock<MutexSys> lock(arenaMutex);
+      if (threads == arenaThreads && priority == arenaPriority)
+        return;
+      arenaThreads = threads;
+      arenaPriority = priority;
+      if (threads == 0 && priority == RTC_BUILD_PRIORITY_NORMAL) {
+        arena.reset();
+        return;
+      }
+      const int maxConcurrency = threads ? int(threads) : int(TaskScheduler::tbbThreadCount());
+#if TBB_VERSION_MAJOR >= 2021
+      tbb::task_arena::priority tbbPriority = tbb::task_arena::priority::normal;
+      if (priority == RTC_BUILD_PRIORITY_LOW ) tbbPriority = tbb::task_arena::priority::low;
+      if (priority == RTC_BUILD_PRIORITY_HIGH) tbbPriority = tbb::task_arena::priority::high;
+      arena = std::make_shared<tbb::task_arena>(maxConcurrency,1,tbbPriority);
+#else
+      arena = std::make_shared<tbb::task_arena>(maxConcurrency,1);
+#endif
+    }
+
+    /*! executes func inside the build arena, or the device arena if no build arena is required */
+    void execute(Device* device, bool join, const std::function<void()>& func)
+    {
+      std::shared_ptr<tbb::task_arena> buildArena = getArena();
+      if (buildArena) buildArena->execute(func);
+      else device->execute(join,func);
+    }
+#endif
   };
 
   /* error raising rtcIntersect and rtcOccluded functions */
@@ -45,6 +91,7 @@ namespace embree
       flags_modified(true), enabled_geometry_types(0),
       scene_flags(RTC_SCENE_FLAG_NONE),
       quality_flags(RTC_BUILD_QUALITY_MEDIUM),
+      build_threads(0), build_priority(RTC_BUILD_PRIORITY_NORMAL),
       modified(true),
       taskGroup(new TaskGroup()),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0)
@@ -132,7 +179,7 @@ namespace embree
           if (device->canUseAVX())
 	  {
             if (quality_flags == RTC_BUILD_QUALITY_HIGH) 
-              accels_add(device->bvh8_factory->BVH8Triangle4(this,BVHFactory::BuildVariant::HIGH_QUALITY,BVHFactory::IntersectVariant::FAST));
+              accels_add(device->bvh8_factory->BVH8Triangle4w(this,BVHFactory::BuildVariant::HIGH_QUALITY,BVHFactory::IntersectVariant::FAST));
             else
               accels_add(device->bvh8_factory->BVH8Triangle4(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST));
           }
@@ -140,7 +187,7 @@ namespace embree
 #endif
           { 
             if (quality_flags == RTC_BUILD_QUALITY_HIGH) 
-              accels_add(device->bvh4_factory->BVH4Triangle4(this,BVHFactory::BuildVariant::HIGH_QUALITY,BVHFactory::IntersectVariant::FAST));
+              accels_add(device->bvh4_factory->BVH4Triangle4w(this,BVHFactory::BuildVariant::HIGH_QUALITY,BVHFactory::IntersectVariant::FAST));
             else 
               accels_add(device->bvh4_factory->BVH4Triangle4(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST));
           }
@@ -188,14 +235,19 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4")       accels_add(device->bvh4_factory->BVH4Triangle4 (this));
     else if (device->tri_accel == "bvh4.triangle4v")      accels_add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels_add(device->bvh4_factory->BVH4Triangle4i(this));
+    else if (device->tri_accel == "bvh4.triangle4w")      accels_add(device->bvh4_factory->BVH4Triangle4w(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels_add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
 
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->tri_accel == "bvh8.triangle4")       accels_add(device->bvh8_factory->BVH8Triangle4 (this));
     else if (device->tri_accel == "bvh8.triangle4v")      accels_add(device->bvh8_factory->BVH8Triangle4v(this));
     else if (device->tri_accel == "bvh8.triangle4i")      accels_add(device->bvh8_factory->BVH8Triangle4i(this));
+    else if (device->tri_accel == "bvh8.triangle4w")      accels_add(device->bvh8_factory->BVH8Triangle4w(this));
     else if (device->tri_accel == "qbvh8.triangle4i")     accels_add(device->bvh8_factory->BVH8QuantizedTriangle4i(this));
     else if (device->tri_accel == "qbvh8.triangle4")      accels_add(device->bvh8_factory->BVH8QuantizedTriangle4(this));
+#endif
+#if defined (EMBREE_TARGET_SIMD16)
+    else if (device->tri_accel == "bvh16.triangle4")      accels_add(device->bvh16_factory->BVH16Triangle4(this));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown triangle acceleration structure "+device->tri_accel);
 #endif
@@ -391,9 +443,11 @@ namespace embree
     }
     else if (device->hair_accel == "bvh4obb.virtualcurve4v" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4v(this,BVHFactory::IntersectVariant::FAST));
     else if (device->hair_accel == "bvh4obb.virtualcurve4i" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4i(this,BVHFactory::IntersectVariant::FAST));
+    else if (device->hair_accel == "bvh4obb.virtualcurve4c" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4c(this,BVHFactory::IntersectVariant::FAST));
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->hair_accel == "bvh8obb.virtualcurve8v" ) accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8v(this,BVHFactory::IntersectVariant::FAST));
     else if (device->hair_accel == "bvh4obb.virtualcurve8i" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve8i(this,BVHFactory::IntersectVariant::FAST));
+    else if (device->hair_accel == "bvh8obb.virtualcurve8c" ) accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8c(this,BVHFactory::IntersectVariant::FAST));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown hair acceleration structure "+device->hair_accel);
 #endif
@@ -637,6 +691,25 @@ namespace embree
   }
 
 
+  bool Scene::createMixedAccel()
+  {
+    if (!device->mixed_accel || quality_flags == RTC_BUILD_QUALITY_LOW || !isFastAccel())
+      return false;
+
+    /* only worth it if static primitives of at least two types are present */
+    const Geometry::GTypeMask groups[] = {
+      TriangleMesh::geom_type, QuadMesh::geom_type, Geometry::MTY_CURVES, UserGeometry::geom_type, Geometry::MTY_INSTANCE
+    };
+    size_t numGroups = 0;
+    for (auto group : groups)
+      numGroups += getNumPrimitives(group,false) != 0;
+    if (numGroups < 2)
+      return false;
+
+    accels_add(device->bvh4_factory->BVH4Mixed(this));
+    return true;
+  }
+
   void Scene::createGridAccel()
   {
 #if defined(EMBREE_GEOMETRY_GRID)
@@ -742,21 +815,24 @@ namespace embree
           geometryModCounters_[i] = 0;
         });
 
-      if (getNumPrimitives(TriangleMesh::geom_type,false)) createTriangleAccel();
+      /* a single BVH replaces the static accels of the mixed types */
+      const bool mixed = createMixedAccel();
+
+      if (!mixed && getNumPrimitives(TriangleMesh::geom_type,false)) createTriangleAccel();
       if (getNumPrimitives(TriangleMesh::geom_type,true)) createTriangleMBAccel();
-      if (getNumPrimitives(QuadMesh::geom_type,false)) createQuadAccel();
+      if (!mixed && getNumPrimitives(QuadMesh::geom_type,false)) createQuadAccel();
       if (getNumPrimitives(QuadMesh::geom_type,true)) createQuadMBAccel();
       if (getNumPrimitives(GridMesh::geom_type,false)) createGridAccel();
       if (getNumPrimitives(GridMesh::geom_type,true)) createGridMBAccel();
       if (getNumPrimitives(SubdivMesh::geom_type,false)) createSubdivAccel();
       if (getNumPrimitives(SubdivMesh::geom_type,true)) createSubdivMBAccel();
-      if (getNumPrimitives(Geometry::MTY_CURVES,false)) createHairAccel();
+      if (!mixed && getNumPrimitives(Geometry::MTY_CURVES,false)) createHairAccel();
       if (getNumPrimitives(Geometry::MTY_CURVES,true)) createHairMBAccel();
-      if (getNumPrimitives(UserGeometry::geom_type,false)) createUserGeometryAccel();
+      if (!mixed && getNumPrimitives(UserGeometry::geom_type,false)) createUserGeometryAccel();
       if (getNumPrimitives(UserGeometry::geom_type,true)) createUserGeometryMBAccel();
-      if (getNumPrimitives(Geometry::MTY_INSTANCE_CHEAP,false)) createInstanceAccel();
+      if (!mixed && getNumPrimitives(Geometry::MTY_INSTANCE_CHEAP,false)) createInstanceAccel();
       if (getNumPrimitives(Geometry::MTY_INSTANCE_CHEAP,true)) createInstanceMBAccel();
-      if (getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,false)) createInstanceExpensiveAccel();
+      if (!mixed && getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,false)) createInstanceExpensiveAccel();
       if (getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,true)) createInstanceExpensiveMBAccel();
       if (getNumPrimitives(Geometry::MTY_INSTANCE_ARRAY,false)) createInstanceArrayAccel();
       if (getNumPrimitives(Geometry::MTY_INSTANCE_ARRAY,true)) createInstanceArrayMBAccel();
@@ -866,11 +942,184 @@ namespace embree
   RTCSceneFlags Scene::getSceneFlags() const {
     return scene_flags;
   }
+
+  void Scene::setBuildThreadCount(unsigned int threadCount) {
+    build_threads = threadCount;
+  }
+
+  void Scene::setBuildPriority(RTCBuildPriority priority) {
+    build_priority = priority;
+  }
+
+  void Scene::commit_external ()
+  {
+    /* the build executes inside the application's scheduler, thus
+       joining threads just wait for the build to finish */
+    Lock<MutexSys> lock(buildMutex);
+
+    /* for best performance set FTZ and DAZ flags in the MXCSR control and status register */
+    const unsigned int mxcsr = _mm_getcsr();
+    _mm_setcsr(mxcsr | /* FTZ */ (1<<15) | /* DAZ */ (1<<6));
+
+    try {
+      commit_task();
+
+      /* reset MXCSR register again */
+      _mm_setcsr(mxcsr);
+    }
+    catch (...)
+    {
+      /* reset MXCSR register again */
+      _mm_setcsr(mxcsr);
+
+      accels_clear();
+      throw;
+    }
+  }
+
+  void Scene::commit_sequential ()
+  {
+    /* small builds execute on the calling thread without any task
+       scheduler setup, all parallel algorithms run sequentially */
+    ExternalTaskScheduler::SequentialScope sequential;
+    commit_external();
+  }
+
+  bool Scene::isSmallScene () const
+  {
+    if (geometries.size() >= Builder::SMALL_SCENE_THRESHOLD)
+      return false;
+
+    size_t numPrimitives = 0;
+    for (size_t i=0; i<geometries.size(); i++)
+    {
+      Geometry* geom = geometries[i].ptr;
+      if (!geom || !geom->isEnabled()) continue;
+      numPrimitives += geom->size();
+      if (numPrimitives >= Builder::SMALL_SCENE_THRESHOLD)
+        return false;
+    }
+    return true;
+  }
+
+  void Scene::commitScenes(Scene** scenes_in, size_t numScenes)
+  {
+    /* remove duplicate scenes */
+    std::vector<Scene*> scenes;
+    std::map<Scene*,size_t> sceneIndex;
+    for (size_t i=0; i<numScenes; i++) {
+      if (sceneIndex.find(scenes_in[i]) != sceneIndex.end()) continue;
+      sceneIndex[scenes_in[i]] = scenes.size();
+      scenes.push_back(scenes_in[i]);
+    }
+    const size_t N = scenes.size();
+
+    /* gather instanced scenes that are part of the list and estimate build sizes */
+    std::vector<std::vector<size_t>> children(N);
+    std::vector<size_t> numPrimitives(N,0);
+    std::vector<Scene*> instanced;
+    for (size_t i=0; i<N; i++)
+    {
+      Scene* scene = scenes[i];
+      for (size_t geomID=0; geomID<scene->geometries.size(); geomID++)
+      {
+        Geometry* geom = scene->geometries[geomID].ptr;
+        if (!geom || !geom->isEnabled()) continue;
+        numPrimitives[i] += geom->size();
+
+        instanced.clear();
+        geom->getInstancedScenes(instanced);
+        for (Scene* child : instanced) {
+          auto it = sceneIndex.find(child);
+          if (it != sceneIndex.end()) children[i].push_back(it->second);
+        }
+      }
+    }
+
+    /* instanced scenes have to get built before the scenes instancing them */
+    std::vector<size_t> level(N,0);
+    size_t numLevels = N ? 1 : 0;
+    for (size_t iter=0; ; iter++)
+    {
+      bool changed = false;
+      for (size_t i=0; i<N; i++) {
+        for (size_t c : children[i]) {
+          if (level[i] > level[c]) continue;
+          level[i] = level[c]+1;
+          numLevels = max(numLevels,level[i]+1);
+          changed = true;
+        }
+      }
+      if (!changed) break;
+      if (iter >= N) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes instance each other cyclically");
+    }
+
+    std::atomic<bool> cancelled(false);
+    for (size_t l=0; l<numLevels; l++)
+    {
+      /* largest builds first */
+      std::vector<size_t> order;
+      for (size_t i=0; i<N; i++)
+        if (level[i] == l) order.push_back(i);
+      std::stable_sort(order.begin(),order.end(),[&] (size_t a, size_t b) { return numPrimitives[a] > numPrimitives[b]; });
+
+      /* large scenes get a task of their own, small scenes are bundled into single threaded tasks */
+      std::vector<size_t> taskBegin;
+      size_t taskPrimitives = 0;
+      for (size_t i=0; i<order.size(); i++)
+      {
+        const size_t n = numPrimitives[order[i]];
+        if (taskBegin.empty() || n >= Builder::SMALL_SCENE_THRESHOLD || taskPrimitives+n > Builder::SMALL_SCENE_THRESHOLD) {
+          taskBegin.push_back(i);
+          taskPrimitives = 0;
+        }
+        taskPrimitives += n;
+      }
+      taskBegin.push_back(order.size());
+
+      parallel_for(taskBegin.size()-1, [&] (const size_t task)
+      {
+        /* for best performance set FTZ and DAZ flags in the MXCSR control and status register */
+        const unsigned int mxcsr = _mm_getcsr();
+        _mm_setcsr(mxcsr | /* FTZ */ (1<<15) | /* DAZ */ (1<<6));
+
+        for (size_t i=taskBegin[task]; i<taskBegin[task+1] && !cancelled; i++)
+        {
+          Scene* scene = scenes[order[i]];
+          Lock<MutexSys> lock(scene->buildMutex);
+          try {
+            if (numPrimitives[order[i]] < Builder::SMALL_SCENE_THRESHOLD) {
+              ExternalTaskScheduler::SequentialScope sequential;
+              scene->commit_task();
+            }
+            else
+              scene->commit_task();
+          }
+          catch (...) {
+            _mm_setcsr(mxcsr);
+            scene->accels_clear();
+            cancelled = true;
+            throw;
+          }
+        }
+
+        /* reset MXCSR register again */
+        _mm_setcsr(mxcsr);
+      });
+    }
+  }
                    
 #if defined(TASKING_INTERNAL)
 
   void Scene::commit (bool join) 
   {
+    if (ExternalTaskScheduler::enabled())
+      return commit_external();
+
+    /* small scenes get built on the calling thread */
+    if (!join && isSmallScene())
+      return commit_sequential();
+
     Lock<MutexSys> buildLock(buildMutex,false);
 
     /* allocates own taskscheduler for each build */
@@ -880,7 +1129,7 @@ namespace embree
       scheduler = taskGroup->scheduler;
       if (scheduler == null) {
         buildLock.lock();
-        taskGroup->scheduler = scheduler = new TaskScheduler;
+        taskGroup->scheduler = scheduler = new TaskScheduler(build_threads,int(build_priority)-int(RTC_BUILD_PRIORITY_NORMAL));
       }
     }
 
@@ -913,6 +1162,13 @@ namespace embree
 
   void Scene::commit (bool join) 
   {    
+    if (ExternalTaskScheduler::enabled())
+      return commit_external();
+
+    /* small scenes get built on the calling thread */
+    if (!join && isSmallScene())
+      return commit_sequential();
+
 #if defined(TASKING_TBB) && (TBB_INTERFACE_VERSION_MAJOR < 8)
     if (join)
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcJoinCommitScene not supported with this TBB version");
@@ -930,7 +1186,11 @@ namespace embree
 #endif
       
       do {
+#if USE_TASK_ARENA
+        taskGroup->execute(device, join, [&](){ taskGroup->group.wait(); });
+#else
         device->execute(join, [&](){ taskGroup->group.wait(); });
+#endif
 
         pause_cpu();
         yield();
@@ -950,14 +1210,19 @@ namespace embree
 #else
       tbb::task_group_context ctx( tbb::task_group_context::isolated, tbb::task_group_context::default_traits | tbb::task_group_context::fp_settings );
 #endif
-      //ctx.set_priority(tbb::priority_high);
-      device->execute(join, [&]()
+      auto build = [&]()
       {
         taskGroup->group.run([&]{
             tbb::parallel_for (size_t(0), size_t(1), size_t(1), [&] (size_t) { commit_task(); }, ctx);
           });
         taskGroup->group.wait();
-      });
+      };
+#if USE_TASK_ARENA
+      taskGroup->updateArena(build_threads,build_priority);
+      taskGroup->execute(device, join, build);
+#else
+      device->execute(join, build);
+#endif
 
       /* reset MXCSR register again */
       _mm_setcsr(mxcsr);
@@ -977,6 +1242,13 @@ namespace embree
 
   void Scene::commit (bool join) 
   {
+    if (ExternalTaskScheduler::enabled())
+      return commit_external();
+
+    /* small scenes get built on the calling thread */
+    if (!join && isSmallScene())
+      return commit_sequential();
+
 #if defined(TASKING_PPL)
     if (join)
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcJoinCommitScene not supported with PPL");
@@ -170,6 +170,7 @@ namespace embree
     void createInstanceArrayMBAccel();
     void createGridAccel();
     void createGridMBAccel();
+    bool createMixedAccel();
 
     /*! prints statistics about the scene */
     void printStatistics();
@@ -186,10 +187,17 @@ namespace embree
     void setSceneFlags(RTCSceneFlags scene_flags);
     RTCSceneFlags getSceneFlags() const;
 
+    void setBuildThreadCount(unsigned int threadCount);
+    void setBuildPriority(RTCBuildPriority priority);
+
     void build_cpu_accels();
     void build_gpu_accels();
     void commit (bool join);
     void commit_task ();
+    void commit_external ();
+    void commit_sequential ();
+    bool isSmallScene () const;
+    static void commitScenes (Scene** scenes, size_t numScenes);
     void build () {}
 
     /* return number of geometries */
@@ -287,6 +295,8 @@ namespace embree
     
     RTCSceneFlags scene_flags;
     RTCBuildQuality quality_flags;
+    unsigned int build_threads;       //!< maximal number of threads of a build, 0 for unlimited
+    RTCBuildPriority build_priority;  //!< priority of builds relative to concurrent builds
     MutexSys buildMutex;
     MutexSys geometriesMutex;
 
@@ -12,6 +12,8 @@ namespace embree
     : Geometry(device,Geometry::GTY_INSTANCE_CHEAP,1,numTimeSteps)
     , object(object)
     , local2world(nullptr)
+    , flat_object(nullptr)
+    , flat_depth(0)
   {
     if (object) object->refInc();
     gsubtype = GTY_SUBTYPE_INSTANCE_LINEAR;
@@ -25,6 +27,7 @@ namespace embree
 
   Instance::~Instance()
   {
+    resetFlattened();
     device->free(local2world);
     device->memoryMonitor(-ssize_t(numTimeSteps*sizeof(AffineSpace3ff)), true);
     if (object) object->refDec();
@@ -62,7 +65,11 @@ namespace embree
     Geometry::update();
   }
 
-#if 0
+  void Instance::getInstancedScenes(std::vector<Scene*>& scenes) const
+  {
+    if (object) scenes.push_back(static_cast<Scene*>(object));
+  }
+
   void Instance::preCommit()
   {
 #if 0 // disable expensive instance optimization for now
@@ -77,8 +84,62 @@ namespace embree
 #endif
 
     Geometry::preCommit();
+    flatten();
+  }
+
+  void Instance::resetFlattened()
+  {
+    if (flat_object) flat_object->refDec();
+    flat_object = nullptr;
+    flat_depth = 0;
   }
+
+  void Instance::flatten()
+  {
+    resetFlattened();
+
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+    if (!device->instancing_flatten || numTimeSteps != 1 || object == nullptr)
+      return;
+
+    /* the instanced scene has to consist of a single static instance */
+    const Scene* scene = (const Scene*) object;
+    if (scene->world.size() != 1 || scene->world.numInstancesCheap + scene->world.numInstancesExpensive != 1)
+      return;
+
+    for (size_t geomID=0; geomID<scene->size(); geomID++)
+    {
+      const Geometry* geom = scene->get(geomID);
+      if (geom == nullptr || !geom->isEnabled()) continue;
+      if (!(geom->getTypeMask() & Geometry::MTY_INSTANCE)) return;
+
+      const Instance* child = (const Instance*) geom;
+      if (child->numTimeSteps != 1 || child->object == nullptr) return;
+
+      /* skipping the mask test of the child requires it to pass whenever ours passes */
+      if ((child->mask & mask) != mask) return;
+
+      /* the whole chain including this instance has to fit onto the instance stack */
+      const unsigned int depth = 1 + child->flat_depth;
+      if (depth >= RTC_MAX_INSTANCE_LEVEL_COUNT) return;
+
+      flat_instIDs[0] = (unsigned int) geomID;
+      for (unsigned int l=1; l<depth; l++)
+        flat_instIDs[l] = child->flat_instIDs[l-1];
+
+      if (child->isFlattened()) {
+        flat_object = child->flat_object;
+        flat_world2local = child->flat_world2local * world2local0;
+      } else {
+        flat_object = child->object;
+        flat_world2local = child->getWorld2Local() * world2local0;
+      }
+      flat_object->refInc();
+      flat_depth = depth;
+      return;
+    }
 #endif
+  }
 
   void Instance::addElementsToCount (GeometryCounts & counts) const 
   {
@@ -47,6 +47,7 @@ namespace embree
   public:
     virtual void setNumTimeSteps (unsigned int numTimeSteps) override;
     virtual void setInstancedScene(const Ref<Scene>& scene) override;
+    virtual void getInstancedScenes(std::vector<Scene*>& scenes) const override;
     virtual void setTransform(const AffineSpace3fa& local2world, unsigned int timeStep) override;
     virtual void setQuaternionDecomposition(const AffineSpace3ff& qd, unsigned int timeStep) override;
     virtual AffineSpace3fa getTransform(float time) override;
@@ -55,6 +56,11 @@ namespace embree
     virtual void build() {}
     virtual void addElementsToCount (GeometryCounts & counts) const override;
     virtual void commit() override;
+    virtual void preCommit() override;
+
+  private:
+    void flatten();
+    void resetFlattened();
 
   public:
 
@@ -164,6 +170,11 @@ namespace embree
       return area(bounds(i));
     }
 
+    /*! returns true if this instance roots a collapsed chain of nested instances */
+    __forceinline bool isFlattened() const {
+      return flat_object != nullptr;
+    }
+
     private:
 
     template<int K>
@@ -221,6 +232,15 @@ namespace embree
     Accel* object;                 //!< pointer to instanced acceleration structure
     AffineSpace3ff* local2world;   //!< transformation from local space to world space for each timestep (either normal matrix or quaternion decomposition)
     AffineSpace3fa world2local0;   //!< transformation from world space to local space for timestep 0
+
+    /* A static instance of a scene that contains nothing but another
+     * static instance is collapsed at commit time, such that traversal
+     * pushes all instance IDs of the chain at once and directly
+     * continues in the innermost scene with the combined transform. */
+    Accel* flat_object;            //!< innermost instanced scene of the collapsed chain, or nullptr
+    AffineSpace3fa flat_world2local; //!< transformation from world space to the space of flat_object
+    unsigned int flat_depth;       //!< number of nested instances collapsed below this instance
+    unsigned int flat_instIDs[RTC_MAX_INSTANCE_LEVEL_COUNT]; //!< geometry IDs of the collapsed nested instances
   };
 
   namespace isa
@@ -4,6 +4,7 @@
 #include "scene_instance_array.h"
 #include "scene.h"
 #include "motion_derivative.h"
+#include "../../common/algorithms/parallel_for.h"
 namespace embree
 {
 #if defined(EMBREE_LOWEST_ISA)
@@ -16,11 +17,15 @@ namespace embree
     numObjects = 0;
     gsubtype = GTY_SUBTYPE_INSTANCE_LINEAR;
     l2w_buf.resize(numTimeSteps);
+    xfm_cache_stride = 0;
+    xfm_cache_modified = range<size_t>(0,0);
     device->memoryMonitor(sizeof(*this), false);
   }
 
   InstanceArray::~InstanceArray()
   {
+    if (xfm_cache_stride)
+      device->memoryMonitor(-ssize_t(l2w_cache.size()*sizeof(float)+w2l_cache.size()*sizeof(AffineSpace3fa)), true);
     if (object) object->refDec();
     if (objects) {
       for (size_t i = 0; i < numObjects; ++i) {
@@ -68,6 +73,14 @@ namespace embree
     Geometry::update();
   }
 
+  void InstanceArray::getInstancedScenes(std::vector<Scene*>& scenes) const
+  {
+    if (object) scenes.push_back(static_cast<Scene*>(object));
+    for (size_t i = 0; i < numObjects; ++i) {
+      if (objects[i]) scenes.push_back(static_cast<Scene*>(objects[i]));
+    }
+  }
+
   void InstanceArray::addElementsToCount (GeometryCounts & counts) const 
   {
     if (1 == numTimeSteps) {
@@ -107,6 +120,7 @@ namespace embree
       numPrimitives = num;
       l2w_buf[slot].set(buffer, offset, stride, num, format);
       l2w_buf[slot].checkPadding16();
+      setModifiedTransformRange(0,num);
     }
     else if (type == RTC_BUFFER_TYPE_INDEX)
     {
@@ -150,6 +164,7 @@ namespace embree
       if (slot >= l2w_buf.size())
         throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid transform buffer slot");
       l2w_buf[slot].setModified();
+      setModifiedTransformRange(0,l2w_buf[slot].size());
     }
     else if (type == RTC_BUFFER_TYPE_INDEX)
     {
@@ -165,6 +180,33 @@ namespace embree
     Geometry::update();
   }
 
+  void InstanceArray::updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end)
+  {
+    if (type == RTC_BUFFER_TYPE_TRANSFORM)
+    {
+      if (slot >= l2w_buf.size())
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid transform buffer slot");
+      if (begin > end || end > l2w_buf[slot].size())
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer range");
+      l2w_buf[slot].setModified();
+      setModifiedTransformRange(begin,end);
+    }
+    else if (type == RTC_BUFFER_TYPE_INDEX)
+    {
+      if (slot != 0)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid index buffer slot. must be 0");
+      if (begin > end || end > object_ids.size())
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer range");
+      object_ids.setModified();
+    }
+    else
+    {
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown buffer type");
+    }
+
+    Geometry::update(range<size_t>(begin,end));
+  }
+
   void InstanceArray::setMask (unsigned mask)
   {
     this->mask = mask;
@@ -187,9 +229,57 @@ namespace embree
       if (object) object->refInc();
     }
 
+    /* cache decoded transforms and their inverses of single time step instances */
+    const size_t stride = numTimeSteps == 1 ? (size_t(numPrimitives)+15) & ~size_t(15) : 0;
+    if (stride != xfm_cache_stride)
+    {
+      if (xfm_cache_stride)
+        device->memoryMonitor(-ssize_t(l2w_cache.size()*sizeof(float)+w2l_cache.size()*sizeof(AffineSpace3fa)), true);
+      l2w_cache.clear(); l2w_cache.shrink_to_fit();
+      w2l_cache.clear(); w2l_cache.shrink_to_fit();
+      xfm_cache_stride = 0;
+
+      if (stride) {
+        /* padding allows SIMD loads of all components up to the stride */
+        device->memoryMonitor((12*stride+16)*sizeof(float)+stride*sizeof(AffineSpace3fa), false);
+        l2w_cache.resize(12*stride+16);
+        w2l_cache.resize(stride);
+        xfm_cache_modified = range<size_t>(0,numPrimitives);
+      }
+    }
+    xfm_cache_stride = stride;
+    if (stride)
+      updateTransformCache(xfm_cache_modified.intersect(range<size_t>(0,numPrimitives)));
+    xfm_cache_modified = range<size_t>(0,0);
+
     Geometry::commit();
   }
 
+  void InstanceArray::setModifiedTransformRange(size_t begin, size_t end)
+  {
+    xfm_cache_modified = xfm_cache_modified.merge(range<size_t>(begin,end));
+  }
+
+  void InstanceArray::updateTransformCache(const range<size_t>& r)
+  {
+    if (r.empty()) return;
+    
+    const size_t s = xfm_cache_stride;
+    float* c = l2w_cache.data();
+    parallel_for(r.begin(), r.end(), size_t(4096), [&](const range<size_t>& sub)
+    {
+      for (size_t i=sub.begin(); i<sub.end(); i++)
+      {
+        const AffineSpace3fa local2world = decodeLocal2World(i);
+        c[ 0*s+i] = local2world.l.vx.x; c[ 1*s+i] = local2world.l.vx.y; c[ 2*s+i] = local2world.l.vx.z;
+        c[ 3*s+i] = local2world.l.vy.x; c[ 4*s+i] = local2world.l.vy.y; c[ 5*s+i] = local2world.l.vy.z;
+        c[ 6*s+i] = local2world.l.vz.x; c[ 7*s+i] = local2world.l.vz.y; c[ 8*s+i] = local2world.l.vz.z;
+        c[ 9*s+i] = local2world.p.x;    c[10*s+i] = local2world.p.y;    c[11*s+i] = local2world.p.z;
+        w2l_cache[i] = rcp(local2world);
+      }
+    });
+  }
+
   // TODO InstanceArray: merge this with scene_array.cpp
   namespace {
 
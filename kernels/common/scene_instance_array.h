@@ -50,16 +50,26 @@ namespace embree
     virtual void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num) override;
     virtual void* getBuffer(RTCBufferType type, unsigned int slot) override;
     virtual void updateBuffer(RTCBufferType type, unsigned int slot) override;
+    virtual void updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end) override;
 
     virtual void setNumTimeSteps (unsigned int numTimeSteps) override;
     virtual void setInstancedScene(const Ref<Scene>& scene) override;
     virtual void setInstancedScenes(const RTCScene* scenes, size_t numScenes) override;
+    virtual void getInstancedScenes(std::vector<Scene*>& scenes) const override;
     virtual AffineSpace3fa getTransform(size_t, float time) override;
     virtual void setMask (unsigned mask) override;
     virtual void build() {}
     virtual void addElementsToCount (GeometryCounts & counts) const override;
     virtual void commit() override;
 
+    /*! marks a range of transforms as modified, only this range of the transform cache gets updated on commit */
+    void setModifiedTransformRange(size_t begin, size_t end);
+
+  private:
+
+    /*! updates the transform cache for the specified range of instances */
+    void updateTransformCache(const range<size_t>& r);
+
   public:
 
      /*! calculates the bounds of instance */
@@ -147,11 +157,28 @@ namespace embree
       return true;
     }
 
+    /*! true if the transforms of the instances are cached */
+    __forceinline bool hasTransformCache() const {
+      return xfm_cache_stride != 0;
+    }
+
+    /*! returns the k'th component of the cached local to world transforms, components are stored as l.vx, l.vy, l.vz, p */
+    __forceinline const float* getCachedLocal2World(size_t k) const {
+      assert(hasTransformCache());
+      return l2w_cache.data() + k*xfm_cache_stride;
+    }
+
     __forceinline AffineSpace3fa getLocal2World(size_t i) const
     {
-      if (unlikely(gsubtype == GTY_SUBTYPE_INSTANCE_QUATERNION))
-        return quaternionDecompositionToAffineSpace(l2w(i,0));
-      return l2w(i, 0);
+      if (likely(hasTransformCache())) {
+        const float* c = l2w_cache.data() + i;
+        const size_t s = xfm_cache_stride;
+        return AffineSpace3fa(Vec3fa(c[ 0*s],c[ 1*s],c[ 2*s]),
+                              Vec3fa(c[ 3*s],c[ 4*s],c[ 5*s]),
+                              Vec3fa(c[ 6*s],c[ 7*s],c[ 8*s]),
+                              Vec3fa(c[ 9*s],c[10*s],c[11*s]));
+      }
+      return decodeLocal2World(i);
     }
 
     __forceinline AffineSpace3fa getLocal2World(size_t i, float t) const
@@ -166,6 +193,8 @@ namespace embree
     }
 
     __forceinline AffineSpace3fa getWorld2Local(size_t i) const {
+      if (likely(hasTransformCache()))
+        return w2l_cache[i];
       return rcp(getLocal2World(i));
     }
 
@@ -254,6 +283,14 @@ namespace embree
 
   private:
 
+    /*! decodes the local to world transform of the first time step from the transform buffer */
+    __forceinline AffineSpace3fa decodeLocal2World(size_t i) const
+    {
+      if (unlikely(gsubtype == GTY_SUBTYPE_INSTANCE_QUATERNION))
+        return quaternionDecompositionToAffineSpace(l2w(i,0));
+      return l2w(i, 0);
+    }
+
     __forceinline AffineSpace3ff l2w(size_t i, size_t itime) const {
       if (l2w_buf[itime].getFormat() == RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR) {
         return *(AffineSpace3ff*)(l2w_buf[itime].getPtr(i));
@@ -302,12 +339,17 @@ namespace embree
       return l2w(i, 0);
     }
 
-  private:
+  protected:
     Accel* object;                   //!< fast path if only one scene is instanced
     Accel** objects;
     uint32_t numObjects;
     Device::vector<RawBufferView> l2w_buf = device; //!< transformation from local space to world space for each timestep (either normal matrix or quaternion decomposition)
     BufferView<uint32_t> object_ids; //!< array of scene ids per instance array primitive
+
+    Device::avector<float,64> l2w_cache = device;             //!< decoded local to world transforms of single time step instances in SoA layout
+    Device::avector<AffineSpace3fa,64> w2l_cache = device;    //!< world to local transforms of single time step instances
+    size_t xfm_cache_stride;                                  //!< number of floats per component of l2w_cache, 0 if cache is disabled
+    range<size_t> xfm_cache_modified;                         //!< range of instances to update on next commit
   };
 
   namespace isa
@@ -323,6 +365,9 @@ namespace embree
 
       PrimInfo createPrimRefArray(PrimRef* prims, const range<size_t>& r, size_t k, unsigned int geomID) const
       {
+        if (likely(hasTransformCache() && object))
+          return createPrimRefArrayCached(prims,r,k,geomID);
+
         PrimInfo pinfo(empty);
         for (size_t j = r.begin(); j < r.end(); j++) {
           BBox3fa bounds = empty;
@@ -335,6 +380,49 @@ namespace embree
         return pinfo;
       }
 
+      /* transforms the bounds of the instanced scene for VSIZEX instances at once using the cached transforms */
+      PrimInfo createPrimRefArrayCached(PrimRef* prims, const range<size_t>& r, size_t k, unsigned int geomID) const
+      {
+        PrimInfo pinfo(empty);
+        const BBox3fa obounds = object->bounds.bounds();
+        const float* c[12];
+        for (size_t i=0; i<12; i++)
+          c[i] = getCachedLocal2World(i);
+        
+        for (size_t j = r.begin(); j < r.end(); j += VSIZEX)
+        {
+          const vfloatx vxx = vfloatx::loadu(c[0]+j), vxy = vfloatx::loadu(c[ 1]+j), vxz = vfloatx::loadu(c[ 2]+j);
+          const vfloatx vyx = vfloatx::loadu(c[3]+j), vyy = vfloatx::loadu(c[ 4]+j), vyz = vfloatx::loadu(c[ 5]+j);
+          const vfloatx vzx = vfloatx::loadu(c[6]+j), vzy = vfloatx::loadu(c[ 7]+j), vzz = vfloatx::loadu(c[ 8]+j);
+          const vfloatx px  = vfloatx::loadu(c[9]+j), py  = vfloatx::loadu(c[10]+j), pz  = vfloatx::loadu(c[11]+j);
+
+          /* same operation order as xfmBounds to get identical bounds */
+          Vec3vfx lower(pos_inf), upper(neg_inf);
+          for (size_t corner=0; corner<8; corner++)
+          {
+            const vfloatx x(corner & 4 ? obounds.upper.x : obounds.lower.x);
+            const vfloatx y(corner & 2 ? obounds.upper.y : obounds.lower.y);
+            const vfloatx z(corner & 1 ? obounds.upper.z : obounds.lower.z);
+            const Vec3vfx p(madd(x,vxx,madd(y,vyx,madd(z,vzx,px))),
+                            madd(x,vxy,madd(y,vyy,madd(z,vzy,py))),
+                            madd(x,vxz,madd(y,vyz,madd(z,vzz,pz))));
+            lower = min(lower,p);
+            upper = max(upper,p);
+          }
+
+          const size_t n = min(size_t(VSIZEX),r.end()-j);
+          for (size_t l = 0; l < n; l++) {
+            const BBox3fa bounds(Vec3fa(lower.x[l],lower.y[l],lower.z[l]),Vec3fa(upper.x[l],upper.y[l],upper.z[l]));
+            if (!isvalid(bounds))
+              continue;
+            const PrimRef prim(bounds, geomID, unsigned(j+l));
+            pinfo.add_center2(prim);
+            prims[k++] = prim;
+          }
+        }
+        return pinfo;
+      }
+
       PrimInfo createPrimRefArrayMB(mvector<PrimRef>& prims, size_t itime, const range<size_t>& r, size_t k, unsigned int geomID) const
       {
         PrimInfo pinfo(empty);
@@ -3,6 +3,7 @@
 
 #include "scene_quad_mesh.h"
 #include "scene.h"
+#include "../../common/algorithms/parallel_reduce.h"
 
 namespace embree
 {
@@ -34,13 +35,16 @@ namespace embree
   
   void QuadMesh::setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num)
   { 
-    /* verify that all accesses are 4 bytes aligned */
-    if (((size_t(buffer->getPtr()) + offset) & 0x3) || (stride & 0x3)) 
+    /* verify that all accesses are 4 bytes aligned, 16-bit vertex and index formats only have to be 2 bytes aligned */
+    const bool format16 = (type == RTC_BUFFER_TYPE_VERTEX && (format == RTC_FORMAT_HALF3 || format == RTC_FORMAT_SHORT3))
+                       || (type == RTC_BUFFER_TYPE_INDEX  && format == RTC_FORMAT_USHORT4);
+    const size_t align = format16 ? 0x1 : 0x3;
+    if (((size_t(buffer->getPtr()) + offset) & align) || (stride & align)) 
       throw_RTCError(RTC_ERROR_INVALID_OPERATION, "data must be 4 bytes aligned");
 
     if (type == RTC_BUFFER_TYPE_VERTEX) 
     {
-      if (format != RTC_FORMAT_FLOAT3)
+      if (format != RTC_FORMAT_FLOAT3 && format != RTC_FORMAT_HALF3 && format != RTC_FORMAT_SHORT3)
         throw_RTCError(RTC_ERROR_INVALID_OPERATION, "invalid vertex buffer format");
 
       /* if buffer is larger than 16GB the premultiplied index optimization does not work */
@@ -51,6 +55,7 @@ namespace embree
         throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid vertex buffer slot");
 
       vertices[slot].set(buffer, offset, stride, num, format);
+      vertices[slot].setQuantization(quant_scale, quant_offset);
       vertices[slot].checkPadding16();
       vertices0 = vertices[0];
     } 
@@ -69,7 +74,7 @@ namespace embree
     {
       if (slot != 0)
         throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer slot");
-      if (format != RTC_FORMAT_UINT4)
+      if (format != RTC_FORMAT_UINT4 && format != RTC_FORMAT_USHORT4)
         throw_RTCError(RTC_ERROR_INVALID_OPERATION, "invalid index buffer format");
 
       quads.set(buffer, offset, stride, num, format);
@@ -134,6 +139,44 @@ namespace embree
     Geometry::update();
   }
 
+  void QuadMesh::updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end)
+  {
+    if (type == RTC_BUFFER_TYPE_VERTEX)
+    {
+      if (slot >= vertices.size())
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer slot");
+      if (begin > end || end > vertices[slot].size())
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer range");
+      vertices[slot].setModified();
+      Geometry::update(quadsOfVertexRange(range<size_t>(begin,end)));
+    }
+    else if (type == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE)
+    {
+      if (slot >= vertexAttribs.size())
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer slot");
+      if (begin > end || end > vertexAttribs[slot].size())
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer range");
+      vertexAttribs[slot].setModified();
+      Geometry::update(range<size_t>(0,0)); // vertex attributes do not change the shape
+    }
+    else
+      updateBuffer(type,slot); // modified indices change the topology
+  }
+
+  range<size_t> QuadMesh::quadsOfVertexRange(const range<size_t>& r) const
+  {
+    auto inside = [&] (size_t v) { return v-r.begin() < r.size(); };
+    return parallel_reduce(size_t(0), size(), size_t(4096), range<size_t>(0,0), [&] (const range<size_t>& sub) -> range<size_t>
+    {
+      range<size_t> prims(0,0);
+      for (size_t i=sub.begin(); i<sub.end(); i++) {
+        const Quad& q = quad(i);
+        if (inside(q.v[0]) || inside(q.v[1]) || inside(q.v[2]) || inside(q.v[3])) prims = prims.merge(range<size_t>(i,i+1));
+      }
+      return prims;
+    }, [] (const range<size_t>& a, const range<size_t>& b) { return a.merge(b); });
+  }
+
   void QuadMesh::commit() 
   {
     /* verify that stride of all time steps are identical */
@@ -141,9 +184,24 @@ namespace embree
       if (vertices[t].getStride() != vertices[0].getStride())
         throw_RTCError(RTC_ERROR_INVALID_OPERATION,"stride of vertex buffers have to be identical for each time step");
 
+    /* verify that format of all time steps are identical */
+    for (unsigned int t=0; t<numTimeSteps; t++)
+      if (vertices[t].getFormat() != vertices[0].getFormat())
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"format of vertex buffers have to be identical for each time step");
+
     Geometry::commit();
   }
 
+  void QuadMesh::setVertexQuantization(const Vec3fa& scale, const Vec3fa& offset)
+  {
+    quant_scale = Vec3f(scale);
+    quant_offset = Vec3f(offset);
+    for (auto& buffer : vertices)
+      buffer.setQuantization(quant_scale, quant_offset);
+    vertices0 = vertices[0];
+    Geometry::update();
+  }
+
   void QuadMesh::addElementsToCount (GeometryCounts & counts) const
   {
     if (numTimeSteps == 1) counts.numQuads += numPrimitives;
@@ -160,10 +218,11 @@ namespace embree
 
     /*! verify quad indices */
     for (size_t i=0; i<size(); i++) {     
-      if (quads[i].v[0] >= numVertices()) return false; 
-      if (quads[i].v[1] >= numVertices()) return false; 
-      if (quads[i].v[2] >= numVertices()) return false; 
-      if (quads[i].v[3] >= numVertices()) return false; 
+      const Quad& prim = quad(i);
+      if (prim.v[0] >= numVertices()) return false; 
+      if (prim.v[1] >= numVertices()) return false; 
+      if (prim.v[2] >= numVertices()) return false; 
+      if (prim.v[3] >= numVertices()) return false; 
     }
 
     /*! verify vertices */
@@ -44,9 +44,11 @@ namespace embree
     void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num);
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
+    void updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end);
     void commit();
     bool verify();
     void interpolate(const RTCInterpolateArguments* const args);
+    void setVertexQuantization(const Vec3fa& scale, const Vec3fa& offset);
     void addElementsToCount (GeometryCounts & counts) const;
 
     template<int N>
@@ -77,16 +79,31 @@ namespace embree
         src    = vertices[bufferSlot].getPtr();
         stride = vertices[bufferSlot].getStride();
       }
+
+      const Quad& tri = quad(primID);
+      const char* src0 = &src[tri.v[0]*stride];
+      const char* src1 = &src[tri.v[1]*stride];
+      const char* src2 = &src[tri.v[2]*stride];
+      const char* src3 = &src[tri.v[3]*stride];
+
+      /* half precision and quantized vertex positions get decoded first */
+      Vec3fa decoded[4];
+      if (bufferType == RTC_BUFFER_TYPE_VERTEX && vertices[bufferSlot].isCompressed())
+      {
+        decoded[0] = vertices[bufferSlot][tri.v[0]]; src0 = (const char*) &decoded[0];
+        decoded[1] = vertices[bufferSlot][tri.v[1]]; src1 = (const char*) &decoded[1];
+        decoded[2] = vertices[bufferSlot][tri.v[2]]; src2 = (const char*) &decoded[2];
+        decoded[3] = vertices[bufferSlot][tri.v[3]]; src3 = (const char*) &decoded[3];
+      }
       
       for (unsigned int i=0; i<valueCount; i+=N)
       {
         const vbool<N> valid = vint<N>((int)i)+vint<N>(step) < vint<N>(int(valueCount));
         const size_t ofs = i*sizeof(float);
-        const Quad& tri = quad(primID);
-        const vfloat<N> p0 = mem<vfloat<N>>::loadu(valid,(float*)&src[tri.v[0]*stride+ofs]);
-        const vfloat<N> p1 = mem<vfloat<N>>::loadu(valid,(float*)&src[tri.v[1]*stride+ofs]);
-        const vfloat<N> p2 = mem<vfloat<N>>::loadu(valid,(float*)&src[tri.v[2]*stride+ofs]);
-        const vfloat<N> p3 = mem<vfloat<N>>::loadu(valid,(float*)&src[tri.v[3]*stride+ofs]);      
+        const vfloat<N> p0 = mem<vfloat<N>>::loadu(valid,(float*)&src0[ofs]);
+        const vfloat<N> p1 = mem<vfloat<N>>::loadu(valid,(float*)&src1[ofs]);
+        const vfloat<N> p2 = mem<vfloat<N>>::loadu(valid,(float*)&src2[ofs]);
+        const vfloat<N> p3 = mem<vfloat<N>>::loadu(valid,(float*)&src3[ofs]);
         const vbool<N> left = u+v <= 1.0f;
         const vfloat<N> Q0 = select(left,p0,p2);
         const vfloat<N> Q1 = select(left,p1,p3);
@@ -117,7 +134,12 @@ namespace embree
     }
     
     /*! returns i'th quad */
-    __forceinline const Quad& quad(size_t i) const {
+    __forceinline const Quad quad(size_t i) const
+    {
+      if (unlikely(quads.getFormat() == RTC_FORMAT_USHORT4)) {
+        const unsigned short* v = (const unsigned short*) quads.getPtr(i);
+        return Quad(v[0],v[1],v[2],v[3]);
+      }
       return quads[i];
     }
 
@@ -270,9 +292,19 @@ namespace embree
 
     /*! get fast access to first vertex buffer */
     __forceinline float * getCompactVertexArray () const {
+      if (vertices0.isCompressed()) return nullptr; // decoded through the vertex buffer
       return (float*) vertices0.getPtr();
     }
 
+    /*! returns the multiplier that turns vertex indices into the offsets stored in index leaves */
+    __forceinline unsigned int getVertexOffsetScale() const {
+      if (vertices0.isCompressed()) return 1; // compressed vertices are addressed by index
+      return vertices0.getStride()/4;
+    }
+
+    /*! returns the range of quads that reference vertices of the specified range */
+    range<size_t> quadsOfVertexRange(const range<size_t>& r) const;
+
     /* gets version info of topology */
     unsigned int getTopologyVersion() const {
       return quads.modCounter;
@@ -299,6 +331,8 @@ namespace embree
     BufferView<Vec3fa> vertices0;           //!< fast access to first vertex buffer
     Device::vector<BufferView<Vec3fa>> vertices = device; //!< vertex array for each timestep
     Device::vector<RawBufferView> vertexAttribs = device; //!< vertex attribute buffers
+    Vec3f quant_scale = Vec3f(1.0f);        //!< scale of quantized vertex positions
+    Vec3f quant_offset = Vec3f(0.0f);       //!< offset of quantized vertex positions
   };
 
   namespace isa
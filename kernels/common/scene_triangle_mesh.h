@@ -38,9 +38,11 @@ namespace embree
     void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num);
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
+    void updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end);
     void commit();
     bool verify();
     void interpolate(const RTCInterpolateArguments* const args);
+    void setVertexQuantization(const Vec3fa& scale, const Vec3fa& offset);
     void addElementsToCount (GeometryCounts & counts) const;
 
     template<int N>
@@ -71,16 +73,29 @@ namespace embree
         src    = vertices[bufferSlot].getPtr();
         stride = vertices[bufferSlot].getStride();
       }
+
+      const Triangle& tri = triangle(primID);
+      const char* src0 = &src[tri.v[0]*stride];
+      const char* src1 = &src[tri.v[1]*stride];
+      const char* src2 = &src[tri.v[2]*stride];
+
+      /* half precision and quantized vertex positions get decoded first */
+      Vec3fa decoded[3];
+      if (bufferType == RTC_BUFFER_TYPE_VERTEX && vertices[bufferSlot].isCompressed())
+      {
+        decoded[0] = vertices[bufferSlot][tri.v[0]]; src0 = (const char*) &decoded[0];
+        decoded[1] = vertices[bufferSlot][tri.v[1]]; src1 = (const char*) &decoded[1];
+        decoded[2] = vertices[bufferSlot][tri.v[2]]; src2 = (const char*) &decoded[2];
+      }
       
       for (unsigned int i=0; i<valueCount; i+=N)
       {
         size_t ofs = i*sizeof(float);
         const float w = 1.0f-u-v;
-        const Triangle& tri = triangle(primID);
         const vbool<N> valid = vint<N>((int)i)+vint<N>(step) < vint<N>(int(valueCount));
-        const vfloat<N> p0 = mem<vfloat<N>>::loadu(valid,(float*)&src[tri.v[0]*stride+ofs]);
-        const vfloat<N> p1 = mem<vfloat<N>>::loadu(valid,(float*)&src[tri.v[1]*stride+ofs]);
-        const vfloat<N> p2 = mem<vfloat<N>>::loadu(valid,(float*)&src[tri.v[2]*stride+ofs]);
+        const vfloat<N> p0 = mem<vfloat<N>>::loadu(valid,(float*)&src0[ofs]);
+        const vfloat<N> p1 = mem<vfloat<N>>::loadu(valid,(float*)&src1[ofs]);
+        const vfloat<N> p2 = mem<vfloat<N>>::loadu(valid,(float*)&src2[ofs]);
         
         if (P) {
           mem<vfloat<N>>::storeu(valid,P+i,madd(w,p0,madd(u,p1,v*p2)));
@@ -105,7 +120,12 @@ namespace embree
     }
     
     /*! returns i'th triangle*/
-    __forceinline const Triangle& triangle(size_t i) const {
+    __forceinline const Triangle triangle(size_t i) const
+    {
+      if (unlikely(triangles.getFormat() == RTC_FORMAT_USHORT3)) {
+        const unsigned short* v = (const unsigned short*) triangles.getPtr(i);
+        return Triangle { { v[0], v[1], v[2] } };
+      }
       return triangles[i];
     }
 
@@ -247,9 +267,19 @@ namespace embree
 
     /*! get fast access to first vertex buffer */
     __forceinline float * getCompactVertexArray () const {
+      if (vertices0.isCompressed()) return nullptr; // decoded through the vertex buffer
       return (float*) vertices0.getPtr();
     }
 
+    /*! returns the multiplier that turns vertex indices into the offsets stored in index leaves */
+    __forceinline unsigned int getVertexOffsetScale() const {
+      if (vertices0.isCompressed()) return 1; // compressed vertices are addressed by index
+      return vertices0.getStride()/4;
+    }
+
+    /*! returns the range of triangles that reference vertices of the specified range */
+    range<size_t> trianglesOfVertexRange(const range<size_t>& r) const;
+
     /* gets version info of topology */
     unsigned int getTopologyVersion() const {
       return triangles.modCounter;
@@ -274,6 +304,8 @@ namespace embree
     BufferView<Vec3fa> vertices0;        //!< fast access to first vertex buffer
     Device::vector<BufferView<Vec3fa>> vertices = device; //!< vertex array for each timestep
     Device::vector<RawBufferView> vertexAttribs = device; //!< vertex attributes
+    Vec3f quant_scale = Vec3f(1.0f);     //!< scale of quantized vertex positions
+    Vec3f quant_offset = Vec3f(0.0f);    //!< offset of quantized vertex positions
   };
 
   namespace isa
@@ -34,6 +34,10 @@ namespace embree
   void UserGeometry::setOccludedFunctionN (RTCOccludedFunctionN occluded) {
     intersectorN.occluded = occluded;
   }
+
+  void UserGeometry::enableBatchedCallbacks (bool enable) {
+    batchedCallbacks = enable;
+  }
   
 #endif
 
@@ -19,6 +19,7 @@ namespace embree
     virtual void setBoundsFunction (RTCBoundsFunction bounds, void* userPtr);
     virtual void setIntersectFunctionN (RTCIntersectFunctionN intersect);
     virtual void setOccludedFunctionN (RTCOccludedFunctionN occluded);
+    virtual void enableBatchedCallbacks (bool enable);
     virtual void build() {}
     virtual void addElementsToCount (GeometryCounts & counts) const;
 
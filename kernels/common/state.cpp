@@ -85,6 +85,7 @@ namespace embree
     useSpatialPreSplits = false;
 
     max_triangles_per_leaf = inf;
+    bvh_layout = "default";
 
     tessellation_cache_size = 128*1024*1024;
 
@@ -96,11 +97,14 @@ namespace embree
     grid_accel_mb = "default";
     grid_builder_mb = "default";
 
+    mixed_accel = false;
+
     instancing_open_min = 0;
     instancing_block_size = 0;
     instancing_open_factor = 8.0f; 
     instancing_open_max_depth = 32;
     instancing_open_max = 50000000;
+    instancing_flatten = true;
 
     float_exceptions = false;
     quality_flags = -1;
@@ -118,6 +122,9 @@ namespace embree
 #endif
 
     start_threads = false;
+    tasking_spin_rounds = 1024;
+    tasking_yield_rounds = 32;
+    tasking_park = true;
     enable_selockmemoryprivilege = false;
 #if defined(__LINUX__)
     hugepages = true;
@@ -130,6 +137,7 @@ namespace embree
     alloc_num_main_slots = 0;
     alloc_thread_block_size = 0;
     alloc_single_thread_alloc = -1;
+    alloc_pool_size = 0;
 
     error_function = nullptr;
     error_function_userptr = nullptr;
@@ -267,6 +275,15 @@ namespace embree
       
       else if (tok == Token::Id("start_threads")&& cin->trySymbol("=")) 
         start_threads = cin->get().Int();
+
+      else if (tok == Token::Id("tasking_spin_rounds")&& cin->trySymbol("=")) 
+        tasking_spin_rounds = max(cin->get().Int(),1);
+
+      else if (tok == Token::Id("tasking_yield_rounds")&& cin->trySymbol("=")) 
+        tasking_yield_rounds = cin->get().Int();
+
+      else if (tok == Token::Id("tasking_park")&& cin->trySymbol("=")) 
+        tasking_park = cin->get().Int();
       
       else if (tok == Token::Id("isa") && cin->trySymbol("=")) {
         std::string isa_str = toLowerCase(cin->get().Identifier());
@@ -390,6 +407,8 @@ namespace embree
       }
       else if (tok == Token::Id("instancing_open_max") && cin->trySymbol("="))
         instancing_open_max = cin->get().Int();
+      else if (tok == Token::Id("instancing_flatten") && cin->trySymbol("="))
+        instancing_flatten = cin->get().Int();
 
       else if (tok == Token::Id("subdiv_accel") && cin->trySymbol("="))
         subdiv_accel = cin->get().Identifier();
@@ -401,6 +420,9 @@ namespace embree
       else if (tok == Token::Id("grid_accel_mb") && cin->trySymbol("="))
         grid_accel_mb = cin->get().Identifier();
 
+      else if (tok == Token::Id("mixed_accel") && cin->trySymbol("="))
+        mixed_accel = cin->get().Int();
+
       else if (tok == Token::Id("verbose") && cin->trySymbol("="))
         verbose = cin->get().Int();
       else if (tok == Token::Id("benchmark") && cin->trySymbol("="))
@@ -436,6 +458,9 @@ namespace embree
       else if (tok == Token::Id("presplits") && cin->trySymbol("="))
         useSpatialPreSplits = cin->get().Int() != 0 ? true : false;
 
+      else if (tok == Token::Id("bvh_layout") && cin->trySymbol("="))
+        bvh_layout = cin->get().Identifier();
+
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
@@ -449,6 +474,8 @@ namespace embree
          alloc_thread_block_size = cin->get().Int();
        else if (tok == Token::Id("alloc_single_thread_alloc") && cin->trySymbol("="))
          alloc_single_thread_alloc = cin->get().Int();
+       else if (tok == Token::Id("alloc_pool_size") && cin->trySymbol("="))
+         alloc_pool_size = size_t(cin->get().Float()*1024.0f*1024.0f);
 
       cin->trySymbol(","); // optional , separator
     }
@@ -465,6 +492,11 @@ namespace embree
     std::cout << "  build user threads = " << numUserThreads   << std::endl;
     std::cout << "  start_threads      = " << start_threads << std::endl;
     std::cout << "  affinity           = " << set_affinity << std::endl;
+#if TASKING_INTERNAL
+    std::cout << "  spin rounds        = " << tasking_spin_rounds << std::endl;
+    std::cout << "  yield rounds       = " << tasking_yield_rounds << std::endl;
+    std::cout << "  park threads       = " << tasking_park << std::endl;
+#endif
     std::cout << "  frequency_level    = ";
     switch (frequency_level) {
     case FREQUENCY_SIMD128: std::cout << "simd128" << std::endl; break;
@@ -480,7 +512,9 @@ namespace embree
 
     std::cout << "  verbosity          = " << verbose << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  alloc_pool_size    = " << float(alloc_pool_size)*1E-6 << " MB" << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  bvh_layout         = " << bvh_layout << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel              = " << tri_accel << std::endl;
@@ -533,6 +567,8 @@ namespace embree
     std::cout << "  accel              = " << grid_accel_mb << std::endl;
     std::cout << "  builder            = " << grid_builder_mb << std::endl;
 
+    std::cout << "mixed_accel          = " << mixed_accel << std::endl;
+
     std::cout << "object_accel:" << std::endl;
     std::cout << "  min_leaf_size      = " << object_accel_min_leaf_size << std::endl;
     std::cout << "  max_leaf_size      = " << object_accel_max_leaf_size << std::endl;
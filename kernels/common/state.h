@@ -105,11 +105,15 @@ namespace embree
     std::string grid_accel_mb;           //!< acceleration structure to use for motion blur grids
     std::string grid_builder_mb;         //!< builder for motion blur grids
 
+  public:
+    bool mixed_accel;                    //!< use a single BVH for all static triangles, quads, curves, user geometries, and instances
+
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     bool useSpatialPreSplits;              //!< use spatial pre-splits instead of the full spatial split builder
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
     size_t max_triangles_per_leaf;
+    std::string bvh_layout;                //!< order of BVH nodes in memory after the build (default, dfs, or veb)
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -117,6 +121,7 @@ namespace embree
     float  instancing_open_factor;         //!< instancing opens tree up to x times the number of instances
     size_t instancing_open_max_depth;      //!< maximum open depth for geometries
     size_t instancing_open_max;            //!< instancing opens tree to maximally that number of subtrees
+    bool   instancing_flatten;             //!< collapses static chains of nested single instances at commit
 
   public:
     bool float_exceptions;                 //!< enable floating point exceptions
@@ -130,6 +135,9 @@ namespace embree
     size_t numUserThreads;                 //!< number of user provided threads to use in builders
     bool set_affinity;                     //!< sets affinity for worker threads
     bool start_threads;                    //!< true when threads should be started at device creation time
+    size_t tasking_spin_rounds;            //!< number of steal attempts of waiting threads before yielding (internal tasking system only)
+    size_t tasking_yield_rounds;           //!< number of yields of waiting threads before parking (internal tasking system only)
+    bool tasking_park;                     //!< parks idle worker threads until new tasks get pushed (internal tasking system only)
     int enabled_cpu_features;              //!< CPU ISA features to use
     int enabled_builder_cpu_features;      //!< CPU ISA features to use for builders only
     enum FREQUENCY_LEVEL {
@@ -146,6 +154,7 @@ namespace embree
     int alloc_num_main_slots;              //!< number of such shared blocks to be used to allocate
     size_t alloc_thread_block_size;        //!< size of thread local allocator block size
     int alloc_single_thread_alloc;         //!< in single mode nodes and leaves use same thread local allocator
+    size_t alloc_pool_size;                //!< maximal size of allocator blocks the device keeps for reuse
 
   public:
 
@@ -0,0 +1,165 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "curveNi.h"
+
+namespace embree
+{
+  /* Curve leaf that extends CurveNi with the control points of each
+   * curve, quantized to 16 bits relative to the bounds of all control
+   * points of the leaf. Compared to CurveNv this halves the storage
+   * of the vertex copy at the cost of a small decode in the
+   * intersector. */
+  template<int M>
+    struct CurveNc : public CurveNi<M>
+  {
+    using CurveNi<M>::N;
+
+    struct Type : public PrimitiveType {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximum number of stored primitives */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+M-1)/M; }
+
+    static __forceinline size_t bytes(size_t N)
+    {
+      const size_t f = N/M, r = N%M;
+      static_assert(sizeof(CurveNc) == 22+25*M+32+4*8*M, "internal data layout issue");
+      return f*sizeof(CurveNc) + (r!=0)*(22 + 25*r + 32 + 4*8*r);
+    }
+
+  public:
+
+    /*! Default constructor. */
+    __forceinline CurveNc () {}
+
+    /*! fill curve from curve list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t _end, Scene* scene)
+    {
+      size_t end = min(begin+M,_end);
+      size_t N = end-begin;
+
+      /* calculate quantization frame over all control points */
+      BBox3fa bounds = empty;
+      float rmax = 0.0f;
+      for (size_t i=0; i<N; i++)
+      {
+        const PrimRef& prim = prims[begin+i];
+        CurveGeometry* mesh = (CurveGeometry*) scene->get(prim.geomID());
+        const unsigned vtxID = mesh->curve(prim.primID());
+        for (size_t j=0; j<4; j++) {
+          const Vec3ff v = mesh->vertex(vtxID+j);
+          bounds.extend(Vec3fa(v));
+          rmax = max(rmax,v.w);
+        }
+      }
+
+      const float extent = reduce_max(bounds.size());
+      const float pscale = extent > 0.0f ? 65535.0f/extent : 0.0f;
+      const float rscale = rmax   > 0.0f ? 65535.0f/rmax   : 0.0f;
+      float* offset = this->decode_offset(N);
+      offset[0] = bounds.lower.x;
+      offset[1] = bounds.lower.y;
+      offset[2] = bounds.lower.z;
+      offset[3] = 0.0f;
+      float* scale = this->decode_scale(N);
+      scale[0] = scale[1] = scale[2] = extent/65535.0f;
+      scale[3] = rmax/65535.0f;
+
+      /* encode all control points */
+      for (size_t i=0; i<N; i++)
+      {
+        const PrimRef& prim = prims[begin+i];
+        CurveGeometry* mesh = (CurveGeometry*) scene->get(prim.geomID());
+        const unsigned vtxID = mesh->curve(prim.primID());
+        for (size_t j=0; j<4; j++)
+        {
+          const Vec3ff v = mesh->vertex(vtxID+j);
+          unsigned short* q = this->vertices(i,N)+4*j;
+          q[0] = (unsigned short) clamp(floor((v.x-offset[0])*pscale+0.5f),0.0f,65535.0f);
+          q[1] = (unsigned short) clamp(floor((v.y-offset[1])*pscale+0.5f),0.0f,65535.0f);
+          q[2] = (unsigned short) clamp(floor((v.z-offset[2])*pscale+0.5f),0.0f,65535.0f);
+          q[3] = (unsigned short) clamp(floor(v.w*rscale+0.5f),0.0f,65535.0f);
+        }
+      }
+    }
+
+    /*! decodes the control points of curve i */
+    __forceinline void gather(Vec3ff& p0, Vec3ff& p1, Vec3ff& p2, Vec3ff& p3, size_t i, size_t N) const
+    {
+      const vfloat4 offset = vfloat4::loadu(this->decode_offset(N));
+      const vfloat4 scale  = vfloat4::loadu(this->decode_scale(N));
+      const unsigned short* q = this->vertices(i,N);
+      p0 = Vec3ff(madd(vfloat4(vint4::load(q+ 0)),scale,offset));
+      p1 = Vec3ff(madd(vfloat4(vint4::load(q+ 4)),scale,offset));
+      p2 = Vec3ff(madd(vfloat4(vint4::load(q+ 8)),scale,offset));
+      p3 = Vec3ff(madd(vfloat4(vint4::load(q+12)),scale,offset));
+    }
+
+    template<typename BVH, typename Allocator>
+      __forceinline static typename BVH::NodeRef createLeaf (BVH* bvh, const PrimRef* prims, const range<size_t>& set, const Allocator& alloc)
+    {
+      if (set.size() == 0)
+        return BVH::emptyNode;
+
+      /* fall back to CurveNi for oriented curves */
+      unsigned int geomID = prims[set.begin()].geomID();
+      if (bvh->scene->get(geomID)->getCurveType() == Geometry::GTY_SUBTYPE_ORIENTED_CURVE) {
+        return CurveNi<M>::createLeaf(bvh,prims,set,alloc);
+      }
+      if (bvh->scene->get(geomID)->getCurveBasis() == Geometry::GTY_BASIS_HERMITE) {
+        return CurveNi<M>::createLeaf(bvh,prims,set,alloc);
+      }
+
+      size_t start = set.begin();
+      size_t items = CurveNc::blocks(set.size());
+      size_t numbytes = CurveNc::bytes(set.size());
+      CurveNc* accel = (CurveNc*) alloc.malloc1(numbytes,BVH::byteAlignment);
+      for (size_t i=0; i<items; i++) {
+        accel[i].CurveNc<M>::fill(prims,start,set.end(),bvh->scene);
+        accel[i].CurveNi<M>::fill(prims,start,set.end(),bvh->scene);
+      }
+      return bvh->encodeLeaf((char*)accel,items);
+    };
+
+  public:
+    unsigned char data[32+4*8*M];
+
+    /*
+    struct Layout
+    {
+      CurveNi<N> base;
+      Vec3f decode_offset; float 0;
+      Vec3f decode_scale; float decode_radius_scale;
+      unsigned short vertices[N][4][4];
+    };
+    */
+
+    __forceinline       float* decode_offset(size_t N)       { return (float*)CurveNi<M>::end(N); }
+    __forceinline const float* decode_offset(size_t N) const { return (float*)CurveNi<M>::end(N); }
+
+    __forceinline       float* decode_scale(size_t N)       { return (float*)CurveNi<M>::end(N)+4; }
+    __forceinline const float* decode_scale(size_t N) const { return (float*)CurveNi<M>::end(N)+4; }
+
+    __forceinline       unsigned short* vertices(size_t i, size_t N)       { return (unsigned short*)(CurveNi<M>::end(N)+32)+16*i; }
+    __forceinline const unsigned short* vertices(size_t i, size_t N) const { return (unsigned short*)(CurveNi<M>::end(N)+32)+16*i; }
+  };
+
+  template<int M>
+    typename CurveNc<M>::Type CurveNc<M>::type;
+
+  typedef CurveNc<4> Curve4c;
+  typedef CurveNc<8> Curve8c;
+}
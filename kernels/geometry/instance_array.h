@@ -75,7 +75,7 @@ namespace embree
 
     /* Updates the primitive */
     __forceinline BBox3fa update(InstanceArray* instanceArray) {
-      return instanceArray->bounds(0);
+      return instanceArray->bounds(primID_);
     }
 
   public:
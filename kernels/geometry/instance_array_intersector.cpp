@@ -32,6 +32,7 @@ namespace embree
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.multihit = context->multihit;
         object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -62,6 +63,8 @@ namespace embree
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.transmittance = context->transmittance;
+        newcontext.minTransmittance = context->minTransmittance;
         object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -128,6 +131,7 @@ namespace embree
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.multihit = context->multihit;
         object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -157,6 +161,8 @@ namespace embree
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.transmittance = context->transmittance;
+        newcontext.minTransmittance = context->minTransmittance;
         object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -255,6 +261,8 @@ namespace embree
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.transmittance = context->transmittance;
+        newcontext.minTransmittance = context->minTransmittance;
         object->intersectors.occluded(valid, ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -318,6 +326,8 @@ namespace embree
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.transmittance = context->transmittance;
+        newcontext.minTransmittance = context->minTransmittance;
         object->intersectors.occluded(valid, ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
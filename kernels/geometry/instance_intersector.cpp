@@ -11,6 +11,29 @@ namespace embree
 {
   namespace isa
   {
+    /* Pushes the instance onto the instance stack. If the instance roots a
+     * collapsed chain of nested instances, the IDs of the whole chain are
+     * pushed as well, provided they fit onto the stack. Returns the number
+     * of pushed levels, which is 0 if the stack is full. */
+    static __forceinline unsigned int pushInstance(RTCRayQueryContext* context, unsigned int instID, const Instance* instance)
+    {
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+      if (instance->isFlattened() && context->instStackSize + instance->flat_depth < RTC_MAX_INSTANCE_LEVEL_COUNT)
+      {
+        instance_id_stack::push(context, instID, 0);
+        for (unsigned int l=0; l<instance->flat_depth; l++)
+          instance_id_stack::push(context, instance->flat_instIDs[l], 0);
+        return instance->flat_depth+1;
+      }
+#endif
+      return instance_id_stack::push(context, instID, 0) ? 1 : 0;
+    }
+
+    static __forceinline void popInstance(RTCRayQueryContext* context, unsigned int levels)
+    {
+      for (unsigned int l=0; l<levels; l++)
+        instance_id_stack::pop(context);
+    }
 
     void InstanceIntersector1::intersect(const Precalculations& pre, RayHit& ray, RayQueryContext* context, const InstancePrimitive& prim)
     {
@@ -22,18 +45,22 @@ namespace embree
         return;
 #endif
       RTCRayQueryContext* user_context = context->user;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
+      const unsigned int levels = pushInstance(user_context, prim.instID_, instance);
+      if (likely(levels))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local();
+        const bool flat = levels > 1;
+        Accel* object = flat ? instance->flat_object : instance->object;
+        const AffineSpace3fa world2local = flat ? instance->flat_world2local : instance->getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
-        instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
+        RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.multihit = context->multihit;
+        object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
-        instance_id_stack::pop(user_context);
+        popInstance(user_context, levels);
       }
     }
     
@@ -49,19 +76,24 @@ namespace embree
       
       RTCRayQueryContext* user_context = context->user;
       bool occluded = false;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
+      const unsigned int levels = pushInstance(user_context, prim.instID_, instance);
+      if (likely(levels))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local();
+        const bool flat = levels > 1;
+        Accel* object = flat ? instance->flat_object : instance->object;
+        const AffineSpace3fa world2local = flat ? instance->flat_world2local : instance->getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
-        instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
+        RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.transmittance = context->transmittance;
+        newcontext.minTransmittance = context->minTransmittance;
+        object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
-        instance_id_stack::pop(user_context);
+        popInstance(user_context, levels);
       }
       return occluded;
     }
@@ -111,18 +143,22 @@ namespace embree
 #endif
       
       RTCRayQueryContext* user_context = context->user;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
+      const unsigned int levels = pushInstance(user_context, prim.instID_, instance);
+      if (likely(levels))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
+        const bool flat = levels > 1;
+        Accel* object = flat ? instance->flat_object : instance->object;
+        const AffineSpace3fa world2local = flat ? instance->flat_world2local : instance->getWorld2Local(ray.time());
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
-        instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
+        RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.multihit = context->multihit;
+        object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
-        instance_id_stack::pop(user_context);
+        popInstance(user_context, levels);
       }
     }
     
@@ -138,19 +174,24 @@ namespace embree
       
       RTCRayQueryContext* user_context = context->user;
       bool occluded = false;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
+      const unsigned int levels = pushInstance(user_context, prim.instID_, instance);
+      if (likely(levels))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
+        const bool flat = levels > 1;
+        Accel* object = flat ? instance->flat_object : instance->object;
+        const AffineSpace3fa world2local = flat ? instance->flat_world2local : instance->getWorld2Local(ray.time());
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
-        instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
+        RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.transmittance = context->transmittance;
+        newcontext.minTransmittance = context->minTransmittance;
+        object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
-        instance_id_stack::pop(user_context);      
+        popInstance(user_context, levels);
       }
       return occluded;
     }
@@ -201,18 +242,21 @@ namespace embree
 #endif
         
       RTCRayQueryContext* user_context = context->user;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
+      const unsigned int levels = pushInstance(user_context, prim.instID_, instance);
+      if (likely(levels))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local();
+        const bool flat = levels > 1;
+        Accel* object = flat ? instance->flat_object : instance->object;
+        const AffineSpace3vf<K> world2local = flat ? AffineSpace3vf<K>(instance->flat_world2local) : AffineSpace3vf<K>(instance->getWorld2Local());
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
-        instance->object->intersectors.intersect(valid, ray, &newcontext);
+        RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        object->intersectors.intersect(valid, ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
-        instance_id_stack::pop(user_context);
+        popInstance(user_context, levels);
       }
     }
 
@@ -230,19 +274,24 @@ namespace embree
         
       RTCRayQueryContext* user_context = context->user;
       vbool<K> occluded = false;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
+      const unsigned int levels = pushInstance(user_context, prim.instID_, instance);
+      if (likely(levels))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local();
+        const bool flat = levels > 1;
+        Accel* object = flat ? instance->flat_object : instance->object;
+        const AffineSpace3vf<K> world2local = flat ? AffineSpace3vf<K>(instance->flat_world2local) : AffineSpace3vf<K>(instance->getWorld2Local());
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
-        instance->object->intersectors.occluded(valid, ray, &newcontext);
+        RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.transmittance = context->transmittance;
+        newcontext.minTransmittance = context->minTransmittance;
+        object->intersectors.occluded(valid, ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
-        instance_id_stack::pop(user_context);
+        popInstance(user_context, levels);
       }
       return occluded;    
     }
@@ -260,18 +309,21 @@ namespace embree
 #endif
         
       RTCRayQueryContext* user_context = context->user;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
+      const unsigned int levels = pushInstance(user_context, prim.instID_, instance);
+      if (likely(levels))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
+        const bool flat = levels > 1;
+        Accel* object = flat ? instance->flat_object : instance->object;
+        const AffineSpace3vf<K> world2local = flat ? AffineSpace3vf<K>(instance->flat_world2local) : instance->getWorld2Local<K>(valid, ray.time());
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
-        instance->object->intersectors.intersect(valid, ray, &newcontext);
+        RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        object->intersectors.intersect(valid, ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
-        instance_id_stack::pop(user_context);
+        popInstance(user_context, levels);
       }
     }
 
@@ -289,19 +341,24 @@ namespace embree
         
       RTCRayQueryContext* user_context = context->user;
       vbool<K> occluded = false;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
+      const unsigned int levels = pushInstance(user_context, prim.instID_, instance);
+      if (likely(levels))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
+        const bool flat = levels > 1;
+        Accel* object = flat ? instance->flat_object : instance->object;
+        const AffineSpace3vf<K> world2local = flat ? AffineSpace3vf<K>(instance->flat_world2local) : instance->getWorld2Local<K>(valid, ray.time());
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
-        instance->object->intersectors.occluded(valid, ray, &newcontext);
+        RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.transmittance = context->transmittance;
+        newcontext.minTransmittance = context->minTransmittance;
+        object->intersectors.occluded(valid, ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
-        instance_id_stack::pop(user_context);
+        popInstance(user_context, levels);
       }
       return occluded;
     }
@@ -16,6 +16,125 @@ namespace embree
       __forceinline void operator() (vfloat<M>& u, vfloat<M>& v, Vec3vf<M>& Ng) const {}
     };
 
+    /* Inserts a hit into the sorted hit buffer of a multi-hit ray
+     * query. Once the buffer is full the ray is shortened to the
+     * farthest buffered hit, such that traversal only continues for
+     * hits that can still enter the buffer. */
+    __forceinline bool insertMultiHit(RayHit& ray, RayQueryContext* context, const HitK<1>& h, float t)
+    {
+      RTCRayMultiHit* mh = context->multihit;
+      const unsigned int maxHits = mh->maxHitCount;
+      unsigned int num = mh->hitCount;
+      if (num == maxHits && t >= mh->tfar[num-1])
+        return false;
+
+      /* primitives referenced by multiple leaves report the same hit again */
+      for (unsigned int i=0; i<num; i++)
+      {
+        const RTCHit& o = mh->hit[i];
+        if (o.primID != h.primID || o.geomID != h.geomID) continue;
+        bool same = true;
+        for (unsigned int l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT && same; l++) {
+          same &= o.instID[l] == h.instID[l];
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+          same &= o.instPrimID[l] == h.instPrimID[l];
+#endif
+          if (h.instID[l] == RTC_INVALID_GEOMETRY_ID) break;
+        }
+        if (same) return false;
+      }
+
+      /* insertion sort into the hit buffer */
+      if (num < maxHits) num++;
+      unsigned int i = num-1;
+      for (; i>0 && mh->tfar[i-1] > t; i--) {
+        mh->tfar[i] = mh->tfar[i-1];
+        mh->hit[i] = mh->hit[i-1];
+      }
+      mh->tfar[i] = t;
+      RTCHit& o = mh->hit[i];
+      o.Ng_x = h.Ng.x; o.Ng_y = h.Ng.y; o.Ng_z = h.Ng.z;
+      o.u = h.u; o.v = h.v;
+      o.primID = h.primID;
+      o.geomID = h.geomID;
+      instance_id_stack::copy_UU(h.instID, o.instID);
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+      instance_id_stack::copy_UU(h.instPrimID, o.instPrimID);
+#endif
+      mh->hitCount = num;
+
+      if (num == maxHits)
+        ray.tfar = mh->tfar[num-1];
+      return true;
+    }
+
+    /* Reports a hit of a multi-hit ray query, the intersection filter
+     * only decides whether the hit enters the hit buffer. */
+    template<bool filter>
+    __forceinline bool reportMultiHit(Geometry* geometry, RayHit& ray, RayQueryContext* context, HitK<1>& h, float t)
+    {
+#if defined(EMBREE_FILTER_FUNCTION)
+      if (filter) {
+        if (unlikely(context->hasContextFilter() || geometry->hasIntersectionFilter())) {
+          const float old_t = ray.tfar;
+          ray.tfar = t;
+          const bool found = runIntersectionFilter1(geometry,ray,context,h);
+          t = ray.tfar;
+          ray.tfar = old_t;
+          if (!found) return false;
+        }
+      }
+#endif
+      return insertMultiHit(ray,context,h,t);
+    }
+
+    /* Attenuates the transmittance of a ray of a transmittance query by
+     * some number of hits of a primitive. Returns true if the hits
+     * occlude the ray, which is the case for opaque geometries and once
+     * the transmittance drops below the threshold of the query. */
+    __forceinline bool attenuateTransmittance(RayQueryContext* context, const Geometry* geometry, unsigned int primID, float& T, size_t hits = 1)
+    {
+      if (!geometry->isTransparent()) return true;
+      const float t = 1.0f - geometry->getOpacity(primID);
+      for (size_t i=0; i<hits; i++) T *= t;
+      return T < context->minTransmittance;
+    }
+
+    /* Attenuates the transmittance of a ray of a transmittance query by
+     * the hits of a leaf and returns the hits that still occlude the ray. */
+    template<int M>
+    __forceinline vbool<M> attenuateTransmittance(const vbool<M>& valid, unsigned int mask, RayQueryContext* context, const vuint<M>& geomIDs, const vuint<M>& primIDs, float& T)
+    {
+      vbool<M> occluded = valid;
+      for (size_t m=movemask(valid); m!=0; )
+      {
+        const size_t i = bscf(m);
+        const Geometry* geometry = context->scene->get(geomIDs[i]);
+#if defined(EMBREE_RAY_MASK)
+        if ((geometry->mask & mask) == 0) {
+          clear(occluded,i);
+          continue;
+        }
+#endif
+        if (attenuateTransmittance(context,geometry,primIDs[i],T))
+          return occluded;
+        clear(occluded,i);
+      }
+      return occluded;
+    }
+
+    /* Attenuates the transmittance of a packet of rays of a transmittance
+     * query by a primitive and returns the rays that are still occluded. */
+    template<int K>
+    __forceinline vbool<K> attenuateTransmittance(const vbool<K>& valid, RayQueryContext* context, const Geometry* geometry, unsigned int primID)
+    {
+      if (!geometry->isTransparent()) return valid;
+      vfloat<K> T = vfloat<K>::loadu(context->transmittance);
+      T = select(valid,T*(1.0f-geometry->getOpacity(primID)),T);
+      vfloat<K>::storeu(context->transmittance,T);
+      return valid & (T < context->minTransmittance);
+    }
+
 
     template<bool filter>
     struct Intersect1Epilog1
@@ -42,6 +161,12 @@ namespace embree
 #endif
         hit.finalize();
 
+        /* gather hit of multi-hit ray query */
+        if (unlikely(context->multihit)) {
+          HitK<1> h(context->user,geomID,primID,hit.u,hit.v,hit.Ng);
+          return reportMultiHit<filter>(geometry,ray,context,h,hit.t);
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -98,6 +223,10 @@ namespace embree
 #endif
         hit.finalize();
 
+        /* semi-transparent hits only attenuate the ray */
+        if (unlikely(context->transmittance))
+          if (!attenuateTransmittance(context,geometry,primID,context->transmittance[0])) return false;
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -199,6 +328,10 @@ namespace embree
           return false;
 #endif
 
+        /* semi-transparent hits only attenuate the ray */
+        if (unlikely(context->transmittance))
+          if (!attenuateTransmittance(context,geometry,primID,context->transmittance[k])) return false;
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -237,6 +370,26 @@ namespace embree
         Scene* scene MAYBE_UNUSED = context->scene;
         vbool<M> valid = valid_i;
         hit.finalize();
+
+        /* gather all hits of multi-hit ray query */
+        if (unlikely(context->multihit))
+        {
+          bool foundhit = false;
+          for (size_t m=movemask(valid); m!=0; )
+          {
+            const size_t i = bscf(m);
+            if (!(hit.t(i) <= ray.tfar)) continue;
+            Geometry* geometry = scene->get(geomIDs[i]);
+#if defined(EMBREE_RAY_MASK)
+            if ((geometry->mask & ray.mask) == 0) continue;
+#endif
+            const Vec2f uv = hit.uv(i);
+            HitK<1> h(context->user,geomIDs[i],primIDs[i],uv.x,uv.y,hit.Ng(i));
+            foundhit |= reportMultiHit<filter>(geometry,ray,context,h,hit.t(i));
+          }
+          return foundhit;
+        }
+
         size_t i = select_min(valid,hit.vt);
         unsigned int geomID = geomIDs[i];
 
@@ -319,12 +472,19 @@ namespace embree
       __forceinline bool operator() (const vbool<M>& valid_i, Hit& hit) const
       {
         Scene* scene MAYBE_UNUSED = context->scene;
+        vbool<M> valid = valid_i;
+
+        /* semi-transparent hits only attenuate the ray */
+        if (unlikely(context->transmittance)) {
+          valid = attenuateTransmittance<M>(valid,ray.mask,context,geomIDs,primIDs,context->transmittance[0]);
+          if (none(valid)) return false;
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
         if (unlikely(filter))
           hit.finalize(); /* called only once */
 
-        vbool<M> valid = valid_i;
         size_t m=movemask(valid);
         goto entry;
         while (true)
@@ -395,6 +555,21 @@ namespace embree
         vbool<M> valid = valid_i;
         hit.finalize();
 
+        /* gather all hits of multi-hit ray query */
+        if (unlikely(context->multihit))
+        {
+          bool foundhit = false;
+          for (size_t m=movemask(valid); m!=0; )
+          {
+            const size_t i = bscf(m);
+            if (!(hit.t(i) <= ray.tfar)) continue;
+            const Vec2f uv = hit.uv(i);
+            HitK<1> h(context->user,geomID,primID,uv.x,uv.y,hit.Ng(i));
+            foundhit |= reportMultiHit<filter>(geometry,ray,context,h,hit.t(i));
+          }
+          return foundhit;
+        }
+
         size_t i = select_min(valid,hit.vt);
 
         /* intersection filter test */
@@ -464,6 +639,10 @@ namespace embree
         if ((geometry->mask & ray.mask) == 0) return false;
 #endif
 
+        /* semi-transparent hits only attenuate the ray */
+        if (unlikely(context->transmittance))
+          if (!attenuateTransmittance(context,geometry,primID,context->transmittance[0],popcnt(valid))) return false;
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (unlikely(context->hasContextFilter() || geometry->hasOcclusionFilter()))
@@ -586,6 +765,12 @@ namespace embree
         if (unlikely(none(valid))) return valid;
 #endif
 
+        /* semi-transparent hits only attenuate the rays */
+        if (unlikely(context->transmittance)) {
+          valid = attenuateTransmittance<K>(valid,context,geometry,primID);
+          if (unlikely(none(valid))) return valid;
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -699,6 +884,12 @@ namespace embree
         if (unlikely(none(valid))) return false;
 #endif
 
+        /* semi-transparent hits only attenuate the rays */
+        if (unlikely(context->transmittance)) {
+          valid = attenuateTransmittance<K>(valid,context,geometry,primID);
+          if (unlikely(none(valid))) return false;
+        }
+
         /* occlusion filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -827,13 +1018,19 @@ namespace embree
       __forceinline bool operator() (const vbool<M>& valid_i, Hit& hit) const
       {
         Scene* scene MAYBE_UNUSED = context->scene;
+        vbool<M> valid = valid_i;
+
+        /* semi-transparent hits only attenuate the ray */
+        if (unlikely(context->transmittance)) {
+          valid = attenuateTransmittance<M>(valid,ray.mask[k],context,geomIDs,primIDs,context->transmittance[k]);
+          if (none(valid)) return false;
+        }
 
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
         if (unlikely(filter))
           hit.finalize(); /* called only once */
 
-        vbool<M> valid = valid_i;
         size_t m=movemask(valid);
         goto entry;
         while (true)
@@ -977,6 +1174,10 @@ namespace embree
           return false;
 #endif
 
+        /* semi-transparent hits only attenuate the ray */
+        if (unlikely(context->transmittance))
+          if (!attenuateTransmittance(context,geometry,primID,context->transmittance[k],popcnt(valid_i))) return false;
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
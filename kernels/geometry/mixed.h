@@ -0,0 +1,76 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "primitive.h"
+#include "../common/scene.h"
+#include "triangle.h"
+#include "quadv.h"
+#include "object.h"
+#include "instance.h"
+#include "curveNi.h"
+#include "linei.h"
+#include "pointi.h"
+
+namespace embree
+{
+  /* Leaf of a BVH that stores primitives of different geometry types in
+   * a single tree. Every leaf starts with the geometry type byte of its
+   * primitives, as curve, line, and point leaves already do. All other
+   * leaves are prefixed by this header that additionally stores the
+   * number of primitive blocks that follow. */
+  struct MixedLeaf
+  {
+    struct Type : public PrimitiveType {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* returns true if leaves of this geometry type are curve, line, or point leaves */
+    static __forceinline bool isCurveType(unsigned int gtype) {
+      return (1u << gtype) & Geometry::MTY_CURVES;
+    }
+
+    /* Returns a key that is equal for all primitives that can share a
+     * leaf. Curve leaves store a single geometry ID, thus each curve
+     * geometry gets its own key. */
+    static __forceinline size_t leafKey(const Scene* scene, unsigned int geomID)
+    {
+      const Geometry* geom = scene->get(geomID);
+      if (isCurveType(geom->getType()))
+        return (size_t(1) << 32) | geomID;
+      if (geom->getTypeMask() & Geometry::MTY_INSTANCE)
+        return Geometry::GTY_INSTANCE_CHEAP;
+      return geom->getType();
+    }
+
+    /* creates a leaf of primitive blocks prefixed by the leaf header */
+    template<typename Primitive, typename BVH, typename Allocator>
+    static __forceinline typename BVH::NodeRef createLeaf(BVH* bvh, unsigned int gtype, const PrimRef* prims, const range<size_t>& set, const Allocator& alloc)
+    {
+      const size_t items = Primitive::blocks(set.size());
+      MixedLeaf* leaf = (MixedLeaf*) alloc.malloc1(sizeof(MixedLeaf)+items*sizeof(Primitive),BVH::byteAlignment);
+      leaf->ty = (unsigned char) gtype;
+      leaf->num = (unsigned char) items;
+      Primitive* accel = (Primitive*) leaf->data();
+      size_t start = set.begin();
+      for (size_t i=0; i<items; i++)
+        accel[i].fill(prims,start,set.end(),bvh->scene);
+      return BVH::encodeLeaf((char*)leaf,1);
+    }
+
+    __forceinline       char* data()       { return (      char*)this + sizeof(MixedLeaf); }
+    __forceinline const char* data() const { return (const char*)this + sizeof(MixedLeaf); }
+
+  public:
+    unsigned char ty;       //!< geometry type of all primitives of the leaf
+    unsigned char num;      //!< number of primitive blocks following the header
+    unsigned char pad[14];  //!< keeps the primitive blocks 16 byte aligned
+  };
+}
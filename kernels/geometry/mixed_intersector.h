@@ -0,0 +1,296 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "mixed.h"
+#include "intersector_iterators.h"
+#include "triangle_intersector.h"
+#include "quadv_intersector.h"
+#include "object_intersector.h"
+#include "instance_intersector.h"
+#include "curve_intersector_virtual.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Intersects a ray with the leaves of a mixed BVH. The type byte of
+     *  the leaf selects the primitive intersector, curve leaves are
+     *  dispatched through the virtual curve intersector of the BVH. */
+    struct MixedIntersector1
+    {
+      typedef unsigned char Primitive;
+      typedef CurvePrecalculations1 Precalculations;
+
+      typedef ArrayIntersector1<TriangleMIntersector1Moeller<4,true>> TriangleIntersector;
+      typedef ArrayIntersector1<QuadMvIntersector1Moeller<4,true>> QuadIntersector;
+      typedef ObjectArrayIntersector1<false> UserIntersector;
+      typedef ArrayIntersector1<InstanceIntersector1> InstanceIntersector;
+
+      template<int N, bool robust>
+      static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive* prim, size_t num, const TravRay<N,robust> &tray, size_t& lazy_node)
+      {
+        const MixedLeaf* leaf = (const MixedLeaf*) prim;
+        switch (leaf->ty)
+        {
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+        case Geometry::GTY_TRIANGLE_MESH: {
+          TriangleIntersector::Precalculations tpre(ray,This->ptr);
+          TriangleIntersector::intersect(This,tpre,ray,context,(const Triangle4*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_QUAD)
+        case Geometry::GTY_QUAD_MESH: {
+          QuadIntersector::Precalculations qpre(ray,This->ptr);
+          QuadIntersector::intersect(This,qpre,ray,context,(const Quad4v*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_USER)
+        case Geometry::GTY_USER_GEOMETRY: {
+          UserIntersector::Precalculations upre(ray,This->ptr);
+          UserIntersector::intersect(This,upre,ray,context,(const Object*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_INSTANCE)
+        case Geometry::GTY_INSTANCE_CHEAP: {
+          InstanceIntersector::Precalculations ipre(ray,This->ptr);
+          InstanceIntersector::intersect(This,ipre,ray,context,(const InstancePrimitive*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+        default:
+          VirtualCurveIntersector1::intersect(This,pre,ray,context,prim,num,tray,lazy_node);
+        }
+      }
+
+      template<int N, bool robust>
+      static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, Ray& ray, RayQueryContext* context, const Primitive* prim, size_t num, const TravRay<N,robust> &tray, size_t& lazy_node)
+      {
+        const MixedLeaf* leaf = (const MixedLeaf*) prim;
+        switch (leaf->ty)
+        {
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+        case Geometry::GTY_TRIANGLE_MESH: {
+          TriangleIntersector::Precalculations tpre(ray,This->ptr);
+          return TriangleIntersector::occluded(This,tpre,ray,context,(const Triangle4*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_QUAD)
+        case Geometry::GTY_QUAD_MESH: {
+          QuadIntersector::Precalculations qpre(ray,This->ptr);
+          return QuadIntersector::occluded(This,qpre,ray,context,(const Quad4v*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_USER)
+        case Geometry::GTY_USER_GEOMETRY: {
+          UserIntersector::Precalculations upre(ray,This->ptr);
+          return UserIntersector::occluded(This,upre,ray,context,(const Object*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_INSTANCE)
+        case Geometry::GTY_INSTANCE_CHEAP: {
+          InstanceIntersector::Precalculations ipre(ray,This->ptr);
+          return InstanceIntersector::occluded(This,ipre,ray,context,(const InstancePrimitive*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+        default:
+          return VirtualCurveIntersector1::occluded(This,pre,ray,context,prim,num,tray,lazy_node);
+        }
+      }
+
+      /* point queries are not supported for curves */
+      template<int N>
+      static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context, const Primitive* prim, size_t num, const TravPointQuery<N> &tquery, size_t& lazy_node)
+      {
+        const MixedLeaf* leaf = (const MixedLeaf*) prim;
+        switch (leaf->ty)
+        {
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+        case Geometry::GTY_TRIANGLE_MESH:
+          return TriangleIntersector::pointQuery(This,query,context,(const Triangle4*)leaf->data(),leaf->num,tquery,lazy_node);
+#endif
+#if defined(EMBREE_GEOMETRY_QUAD)
+        case Geometry::GTY_QUAD_MESH:
+          return QuadIntersector::pointQuery(This,query,context,(const Quad4v*)leaf->data(),leaf->num,tquery,lazy_node);
+#endif
+#if defined(EMBREE_GEOMETRY_USER)
+        case Geometry::GTY_USER_GEOMETRY:
+          return UserIntersector::pointQuery(This,query,context,(const Object*)leaf->data(),leaf->num,tquery,lazy_node);
+#endif
+#if defined(EMBREE_GEOMETRY_INSTANCE)
+        case Geometry::GTY_INSTANCE_CHEAP:
+          return InstanceIntersector::pointQuery(This,query,context,(const InstancePrimitive*)leaf->data(),leaf->num,tquery,lazy_node);
+#endif
+        default:
+          return false;
+        }
+      }
+    };
+
+    template<int K>
+    struct MixedIntersectorK
+    {
+      typedef unsigned char Primitive;
+      typedef CurvePrecalculationsK<K> Precalculations;
+
+      typedef ArrayIntersectorK_1<K,TriangleMIntersectorKMoeller<4,K,true>> TriangleIntersector;
+      typedef ArrayIntersectorK_1<K,QuadMvIntersectorKMoeller<4,K,true>> QuadIntersector;
+      typedef ArrayIntersectorK_1<K,ObjectIntersectorK<K,false>> UserIntersector;
+      typedef ArrayIntersectorK_1<K,InstanceIntersectorK<K>> InstanceIntersector;
+
+      template<bool robust>
+      static __forceinline void intersect(const vbool<K>& valid, const Accel::Intersectors* This, Precalculations& pre, RayHitK<K>& ray, RayQueryContext* context, const Primitive* prim, size_t num, const TravRayK<K, robust> &tray, size_t& lazy_node)
+      {
+        const MixedLeaf* leaf = (const MixedLeaf*) prim;
+        switch (leaf->ty)
+        {
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+        case Geometry::GTY_TRIANGLE_MESH: {
+          typename TriangleIntersector::Precalculations tpre(valid,ray);
+          TriangleIntersector::intersect(valid,This,tpre,ray,context,(const Triangle4*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_QUAD)
+        case Geometry::GTY_QUAD_MESH: {
+          typename QuadIntersector::Precalculations qpre(valid,ray);
+          QuadIntersector::intersect(valid,This,qpre,ray,context,(const Quad4v*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_USER)
+        case Geometry::GTY_USER_GEOMETRY: {
+          typename UserIntersector::Precalculations upre(valid,ray);
+          UserIntersector::intersect(valid,This,upre,ray,context,(const Object*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_INSTANCE)
+        case Geometry::GTY_INSTANCE_CHEAP: {
+          typename InstanceIntersector::Precalculations ipre(valid,ray);
+          InstanceIntersector::intersect(valid,This,ipre,ray,context,(const InstancePrimitive*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+        default:
+          VirtualCurveIntersectorK<K>::intersect(valid,This,pre,ray,context,prim,num,tray,lazy_node);
+        }
+      }
+
+      template<bool robust>
+      static __forceinline vbool<K> occluded(const vbool<K>& valid, const Accel::Intersectors* This, Precalculations& pre, RayK<K>& ray, RayQueryContext* context, const Primitive* prim, size_t num, const TravRayK<K, robust> &tray, size_t& lazy_node)
+      {
+        const MixedLeaf* leaf = (const MixedLeaf*) prim;
+        switch (leaf->ty)
+        {
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+        case Geometry::GTY_TRIANGLE_MESH: {
+          typename TriangleIntersector::Precalculations tpre(valid,ray);
+          return TriangleIntersector::occluded(valid,This,tpre,ray,context,(const Triangle4*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_QUAD)
+        case Geometry::GTY_QUAD_MESH: {
+          typename QuadIntersector::Precalculations qpre(valid,ray);
+          return QuadIntersector::occluded(valid,This,qpre,ray,context,(const Quad4v*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_USER)
+        case Geometry::GTY_USER_GEOMETRY: {
+          typename UserIntersector::Precalculations upre(valid,ray);
+          return UserIntersector::occluded(valid,This,upre,ray,context,(const Object*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_INSTANCE)
+        case Geometry::GTY_INSTANCE_CHEAP: {
+          typename InstanceIntersector::Precalculations ipre(valid,ray);
+          return InstanceIntersector::occluded(valid,This,ipre,ray,context,(const InstancePrimitive*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+        default:
+          return VirtualCurveIntersectorK<K>::occluded(valid,This,pre,ray,context,prim,num,tray,lazy_node);
+        }
+      }
+
+      template<int N, bool robust>
+      static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHitK<K>& ray, size_t k, RayQueryContext* context, const Primitive* prim, size_t num, const TravRay<N,robust> &tray, size_t& lazy_node)
+      {
+        const MixedLeaf* leaf = (const MixedLeaf*) prim;
+        vbool<K> valid = false; set(valid,k);
+        switch (leaf->ty)
+        {
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+        case Geometry::GTY_TRIANGLE_MESH: {
+          typename TriangleIntersector::Precalculations tpre(valid,ray);
+          TriangleIntersector::intersect(This,tpre,ray,k,context,(const Triangle4*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_QUAD)
+        case Geometry::GTY_QUAD_MESH: {
+          typename QuadIntersector::Precalculations qpre(valid,ray);
+          QuadIntersector::intersect(This,qpre,ray,k,context,(const Quad4v*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_USER)
+        case Geometry::GTY_USER_GEOMETRY: {
+          typename UserIntersector::Precalculations upre(valid,ray);
+          UserIntersector::intersect(This,upre,ray,k,context,(const Object*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_INSTANCE)
+        case Geometry::GTY_INSTANCE_CHEAP: {
+          typename InstanceIntersector::Precalculations ipre(valid,ray);
+          InstanceIntersector::intersect(This,ipre,ray,k,context,(const InstancePrimitive*)leaf->data(),leaf->num,tray,lazy_node);
+          break;
+        }
+#endif
+        default:
+          VirtualCurveIntersectorK<K>::intersect(This,pre,ray,k,context,prim,num,tray,lazy_node);
+        }
+      }
+
+      template<int N, bool robust>
+      static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, RayK<K>& ray, size_t k, RayQueryContext* context, const Primitive* prim, size_t num, const TravRay<N,robust> &tray, size_t& lazy_node)
+      {
+        const MixedLeaf* leaf = (const MixedLeaf*) prim;
+        vbool<K> valid = false; set(valid,k);
+        switch (leaf->ty)
+        {
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+        case Geometry::GTY_TRIANGLE_MESH: {
+          typename TriangleIntersector::Precalculations tpre(valid,ray);
+          return TriangleIntersector::occluded(This,tpre,ray,k,context,(const Triangle4*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_QUAD)
+        case Geometry::GTY_QUAD_MESH: {
+          typename QuadIntersector::Precalculations qpre(valid,ray);
+          return QuadIntersector::occluded(This,qpre,ray,k,context,(const Quad4v*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_USER)
+        case Geometry::GTY_USER_GEOMETRY: {
+          typename UserIntersector::Precalculations upre(valid,ray);
+          return UserIntersector::occluded(This,upre,ray,k,context,(const Object*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+#if defined(EMBREE_GEOMETRY_INSTANCE)
+        case Geometry::GTY_INSTANCE_CHEAP: {
+          typename InstanceIntersector::Precalculations ipre(valid,ray);
+          return InstanceIntersector::occluded(This,ipre,ray,k,context,(const InstancePrimitive*)leaf->data(),leaf->num,tray,lazy_node);
+        }
+#endif
+        default:
+          return VirtualCurveIntersectorK<K>::occluded(This,pre,ray,k,context,prim,num,tray,lazy_node);
+        }
+      }
+    };
+  }
+}
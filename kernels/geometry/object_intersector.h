@@ -4,6 +4,7 @@
 #pragma once
 
 #include "object.h"
+#include "intersector_iterators.h"
 #include "../common/ray.h"
 
 namespace embree
@@ -104,6 +105,83 @@ namespace embree
       }
     };
 
+    /*! Intersects a single ray with the user primitives of a leaf. Runs
+     *  of consecutive primitives of a user geometry with batched
+     *  callbacks enabled are passed to a single callback invocation,
+     *  all other primitives are intersected one by one. */
+    template<bool mblur>
+    struct ObjectArrayIntersector1 : public ArrayIntersector1<ObjectIntersector1<mblur>>
+    {
+      typedef ObjectIntersector1<mblur> Intersector;
+      typedef typename Intersector::Primitive Primitive;
+      typedef typename Intersector::Precalculations Precalculations;
+
+      /* maximal number of primitives passed to one callback invocation */
+      static const unsigned int maxBatchSize = 16;
+
+      /* gathers the primIDs of consecutive primitives of the geometry of prim[i] */
+      static __forceinline unsigned int gather(const Primitive* prim, size_t& i, size_t num, unsigned int* primIDs)
+      {
+        const unsigned int geomID = prim[i].geomID();
+        unsigned int primCount = 0;
+        for (; i<num && primCount<maxBatchSize && prim[i].geomID() == geomID; i++)
+          primIDs[primCount++] = prim[i].primID();
+        return primCount;
+      }
+
+      template<int N, bool robust>
+      static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive* prim, size_t num, const TravRay<N,robust> &tray, size_t& lazy_node)
+      {
+        for (size_t i=0; i<num;)
+        {
+          const unsigned int geomID = prim[i].geomID();
+          AccelSet* accel = (AccelSet*) context->scene->get(geomID);
+          if (likely(!accel->batchedCallbacks)) {
+            Intersector::intersect(pre,ray,context,prim[i++]);
+            continue;
+          }
+
+          unsigned int primIDs[maxBatchSize];
+          const unsigned int primCount = gather(prim,i,num,primIDs);
+
+          /* perform ray mask test */
+#if defined(EMBREE_RAY_MASK)
+          if ((ray.mask & accel->mask) == 0)
+            continue;
+#endif
+          accel->intersect(ray,geomID,primIDs,primCount,context);
+        }
+      }
+
+      template<int N, bool robust>
+      static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, Ray& ray, RayQueryContext* context, const Primitive* prim, size_t num, const TravRay<N,robust> &tray, size_t& lazy_node)
+      {
+        for (size_t i=0; i<num;)
+        {
+          const unsigned int geomID = prim[i].geomID();
+          AccelSet* accel = (AccelSet*) context->scene->get(geomID);
+          if (likely(!accel->batchedCallbacks)) {
+            if (Intersector::occluded(pre,ray,context,prim[i++]))
+              return true;
+            continue;
+          }
+
+          unsigned int primIDs[maxBatchSize];
+          const unsigned int primCount = gather(prim,i,num,primIDs);
+
+          /* perform ray mask test */
+#if defined(EMBREE_RAY_MASK)
+          if ((ray.mask & accel->mask) == 0)
+            continue;
+#endif
+          accel->occluded(ray,geomID,primIDs,primCount,context);
+          if (ray.tfar < 0.0f)
+            return true;
+        }
+        return false;
+      }
+    };
+
     template<int K, bool mblur>
     struct ObjectIntersectorK
     {
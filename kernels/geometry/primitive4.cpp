@@ -3,10 +3,12 @@
 
 #include "primitive.h"
 #include "curveNv.h"
+#include "curveNc.h"
 #include "curveNi.h"
 #include "curveNi_mb.h"
 #include "linei.h"
 #include "triangle.h"
+#include "trianglew.h"
 #include "trianglev.h"
 #include "trianglev_mb.h"
 #include "trianglei.h"
@@ -16,6 +18,7 @@
 #include "object.h"
 #include "instance.h"
 #include "instance_array.h"
+#include "mixed.h"
 #include "subgrid.h"
 
 namespace embree
@@ -54,6 +57,40 @@ namespace embree
         return Curve4v::bytes(sizeActive(This));
   }
 
+  /********************** Curve4c **************************/
+
+  template<>
+  const char* Curve4c::Type::name () const {
+    return "curve4c";
+  }
+
+  template<>
+  size_t Curve4c::Type::sizeActive(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->size();
+    else
+      return ((Curve4c*)This)->N;
+  }
+
+  template<>
+  size_t Curve4c::Type::sizeTotal(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return 4;
+    else
+      return ((Curve4c*)This)->N;
+  }
+
+  template<>
+  size_t Curve4c::Type::getBytes(const char* This) const
+  {
+     if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return Line4i::bytes(sizeActive(This));
+     else
+        return Curve4c::bytes(sizeActive(This));
+  }
+
   /********************** Curve4i **************************/
 
   template<>
@@ -188,6 +225,28 @@ namespace embree
     return sizeof(Triangle4v);
   }
 
+  /********************** Triangle4w **************************/
+
+  template<>
+  const char* Triangle4w::Type::name () const {
+    return "triangle4w";
+  }
+
+  template<>
+  size_t Triangle4w::Type::sizeActive(const char* This) const {
+    return ((Triangle4w*)This)->size();
+  }
+
+  template<>
+  size_t Triangle4w::Type::sizeTotal(const char* This) const {
+    return 4;
+  }
+
+  template<>
+  size_t Triangle4w::Type::getBytes(const char* This) const {
+    return sizeof(Triangle4w);
+  }
+
   /********************** Triangle4i **************************/
 
   template<>
@@ -336,6 +395,52 @@ namespace embree
 
   InstancePrimitive::Type InstancePrimitive::type;
 
+  /********************** MixedLeaf **************************/
+
+  const char* MixedLeaf::Type::name () const {
+    return "mixed";
+  }
+
+  size_t MixedLeaf::Type::sizeActive(const char* This) const
+  {
+    const MixedLeaf* leaf = (const MixedLeaf*) This;
+    if (isCurveType(leaf->ty))
+      return Curve4i::type.sizeActive(This);
+
+    size_t n = 0;
+    for (size_t i=0; i<leaf->num; i++)
+    {
+      if      (leaf->ty == Geometry::GTY_TRIANGLE_MESH) n += ((const Triangle4*)leaf->data())[i].size();
+      else if (leaf->ty == Geometry::GTY_QUAD_MESH    ) n += ((const Quad4v*   )leaf->data())[i].size();
+      else n++;
+    }
+    return n;
+  }
+
+  size_t MixedLeaf::Type::sizeTotal(const char* This) const
+  {
+    const MixedLeaf* leaf = (const MixedLeaf*) This;
+    if (isCurveType(leaf->ty))
+      return Curve4i::type.sizeTotal(This);
+    if (leaf->ty == Geometry::GTY_TRIANGLE_MESH || leaf->ty == Geometry::GTY_QUAD_MESH)
+      return 4*leaf->num;
+    return leaf->num;
+  }
+
+  size_t MixedLeaf::Type::getBytes(const char* This) const
+  {
+    const MixedLeaf* leaf = (const MixedLeaf*) This;
+    switch (leaf->ty) {
+    case Geometry::GTY_TRIANGLE_MESH  : return sizeof(MixedLeaf) + leaf->num*sizeof(Triangle4);
+    case Geometry::GTY_QUAD_MESH      : return sizeof(MixedLeaf) + leaf->num*sizeof(Quad4v);
+    case Geometry::GTY_USER_GEOMETRY  : return sizeof(MixedLeaf) + leaf->num*sizeof(Object);
+    case Geometry::GTY_INSTANCE_CHEAP : return sizeof(MixedLeaf) + leaf->num*sizeof(InstancePrimitive);
+    default                           : return Curve4i::type.getBytes(This);
+    }
+  }
+
+  MixedLeaf::Type MixedLeaf::type;
+
   /********************** InstanceArray4 **************************/
 
   const char* InstanceArrayPrimitive::Type::name () const {
@@ -3,6 +3,7 @@
 
 #include "primitive.h"
 #include "curveNv.h"
+#include "curveNc.h"
 #include "curveNi.h"
 #include "curveNi_mb.h"
 #include "linei.h"
@@ -54,6 +55,40 @@ namespace embree
        return Curve8v::bytes(sizeActive(This));
   }
 
+  /********************** Curve8c **************************/
+
+  template<>
+  const char* Curve8c::Type::name () const {
+    return "curve8c";
+  }
+
+  template<>
+  size_t Curve8c::Type::sizeActive(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line8i*)This)->size();
+    else
+      return ((Curve8c*)This)->N;
+  }
+
+  template<>
+  size_t Curve8c::Type::sizeTotal(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return 8;
+    else
+      return ((Curve8c*)This)->N;
+  }
+
+  template<>
+  size_t Curve8c::Type::getBytes(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+       return Line8i::bytes(sizeActive(This));
+     else
+       return Curve8c::bytes(sizeActive(This));
+  }
+
   /********************** Curve8i **************************/
 
   template<>
@@ -124,7 +124,7 @@ namespace embree
 #if !defined(EMBREE_COMPACT_POLYS)
           const QuadMesh* mesh = scene->get<QuadMesh>(prim->geomID());
           const QuadMesh::Quad& q = mesh->quad(prim->primID());
-          unsigned int_stride = mesh->vertices0.getStride()/4;
+          unsigned int_stride = mesh->getVertexOffsetScale();
           v0[i] = q.v[0] * int_stride;
           v1[i] = q.v[1] * int_stride;
           v2[i] = q.v[2] * int_stride;
@@ -206,6 +206,8 @@ namespace embree
 #else
       const vuint<M>& v = getVertexOffset<vid>();
       const float* vertices = scene->vertices[geomID(index)];
+      if (unlikely(vertices == nullptr)) // compressed vertices
+        return (Vec3f) scene->get<QuadMesh>(geomID(index))->vertices0[v[index]];
       return (Vec3f&) vertices[v[index]];
 #endif
     }
@@ -221,10 +223,8 @@ namespace embree
 #else
       const vuint<M>& v = getVertexOffset<vid>();
       const QuadMesh* mesh = scene->get<QuadMesh>(geomID(index));
-      const float* vertices0 = (const float*) mesh->vertexPtr(0,itime+0);
-      const float* vertices1 = (const float*) mesh->vertexPtr(0,itime+1);
-      const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-      const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+      const Vec3fa v0 = loadVertex(mesh,itime+0,v[index]);
+      const Vec3fa v1 = loadVertex(mesh,itime+1,v[index]);
 #endif
       const Vec3<T> p0(v0.x,v0.y,v0.z);
       const Vec3<T> p1(v1.x,v1.y,v1.z);
@@ -245,10 +245,8 @@ namespace embree
         const Vec3fa v1 = mesh->vertices[itime[i]+1][quad.v[vid]];
 #else
         const vuint<M>& v = getVertexOffset<vid>();
-        const float* vertices0 = (const float*) mesh->vertexPtr(0,itime[i]+0);
-        const float* vertices1 = (const float*) mesh->vertexPtr(0,itime[i]+1);
-        const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-        const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+        const Vec3fa v0 = loadVertex(mesh,itime[i]+0,v[index]);
+        const Vec3fa v1 = loadVertex(mesh,itime[i]+1,v[index]);
 #endif
         p0.x[i] = v0.x; p0.y[i] = v0.y; p0.z[i] = v0.z;
         p1.x[i] = v1.x; p1.y[i] = v1.y; p1.z[i] = v1.z;
@@ -295,6 +293,8 @@ namespace embree
     __forceinline Quad loadQuad(const int i, const Scene* const scene) const 
     {
       const float* vertices = scene->vertices[geomID(i)];
+      if (unlikely(vertices == nullptr)) // compressed vertices
+        return loadCompressedQuad(i,scene->get<QuadMesh>(geomID(i))->vertices0);
       const vfloat4 v0 = vfloat4::loadu(vertices + v0_[i]);
       const vfloat4 v1 = vfloat4::loadu(vertices + v1_[i]);
       const vfloat4 v2 = vfloat4::loadu(vertices + v2_[i]);
@@ -306,6 +306,8 @@ namespace embree
     {
       const unsigned int geomID = geomIDs[i];
       const QuadMesh* mesh = scene->get<QuadMesh>(geomID);
+      if (unlikely(mesh->vertices0.isCompressed()))
+        return loadCompressedQuad(i,mesh->vertices[itime]);
       const float* vertices = (const float*) mesh->vertexPtr(0,itime);
       const vfloat4 v0 = vfloat4::loadu(vertices + v0_[i]);
       const vfloat4 v1 = vfloat4::loadu(vertices + v1_[i]);
@@ -313,6 +315,23 @@ namespace embree
       const vfloat4 v3 = vfloat4::loadu(vertices + v3_[i]);
       return { v0, v1, v2, v3 };
     }
+
+    /* half precision and quantized vertices are addressed by vertex index and decoded when loaded */
+    __forceinline Quad loadCompressedQuad(const int i, const BufferView<Vec3fa>& vertices) const
+    {
+      const vfloat4 v0 = (vfloat4) vertices[v0_[i]];
+      const vfloat4 v1 = (vfloat4) vertices[v1_[i]];
+      const vfloat4 v2 = (vfloat4) vertices[v2_[i]];
+      const vfloat4 v3 = (vfloat4) vertices[v3_[i]];
+      return { v0, v1, v2, v3 };
+    }
+
+    static __forceinline Vec3fa loadVertex(const QuadMesh* const mesh, const size_t itime, const unsigned int offset)
+    {
+      if (unlikely(mesh->vertices0.isCompressed()))
+        return mesh->vertices[itime][offset];
+      return Vec3fa::loadu((const float*)mesh->vertexPtr(0,itime) + offset);
+    }
     
 #endif
 
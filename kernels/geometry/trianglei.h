@@ -133,7 +133,7 @@ namespace embree
 #if !defined(EMBREE_COMPACT_POLYS)
           const TriangleMesh* mesh = scene->get<TriangleMesh>(prim->geomID());
           const TriangleMesh::Triangle& tri = mesh->triangle(prim->primID());
-          unsigned int int_stride = mesh->vertices0.getStride()/4;
+          unsigned int int_stride = mesh->getVertexOffsetScale();
           v0[i] = tri.v[0] * int_stride;
           v1[i] = tri.v[1] * int_stride;
           v2[i] = tri.v[2] * int_stride;
@@ -221,6 +221,8 @@ namespace embree
 #else
       const vuint<M>& v = getVertexOffset<vid>();
       const float* vertices = scene->vertices[geomID(index)];
+      if (unlikely(vertices == nullptr)) // compressed vertices
+        return (Vec3f) scene->get<TriangleMesh>(geomID(index))->vertices0[v[index]];
       return (Vec3f&) vertices[v[index]];
 #endif
     }
@@ -236,10 +238,8 @@ namespace embree
 #else
       const vuint<M>& v = getVertexOffset<vid>();
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
-      const float* vertices0 = (const float*) mesh->vertexPtr(0,itime+0);
-      const float* vertices1 = (const float*) mesh->vertexPtr(0,itime+1);
-      const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-      const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+      const Vec3fa v0 = loadVertex(mesh,itime+0,v[index]);
+      const Vec3fa v1 = loadVertex(mesh,itime+1,v[index]);
 #endif
       const Vec3<T> p0(v0.x,v0.y,v0.z);
       const Vec3<T> p1(v1.x,v1.y,v1.z);
@@ -260,10 +260,8 @@ namespace embree
         const Vec3fa v1 = mesh->vertices[itime[i]+1][tri.v[vid]];
 #else
         const vuint<M>& v = getVertexOffset<vid>();
-        const float* vertices0 = (const float*) mesh->vertexPtr(0,itime[i]+0);
-        const float* vertices1 = (const float*) mesh->vertexPtr(0,itime[i]+1);
-        const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-        const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+        const Vec3fa v0 = loadVertex(mesh,itime[i]+0,v[index]);
+        const Vec3fa v1 = loadVertex(mesh,itime[i]+1,v[index]);
 #endif
         p0.x[i] = v0.x; p0.y[i] = v0.y; p0.z[i] = v0.z;
         p1.x[i] = v1.x; p1.y[i] = v1.y; p1.z[i] = v1.z;
@@ -306,6 +304,8 @@ namespace embree
     __forceinline Triangle loadTriangle(const int i, const Scene* const scene) const 
     {
       const float* vertices = scene->vertices[geomID(i)];
+      if (unlikely(vertices == nullptr)) // compressed vertices
+        return loadCompressedTriangle(i,scene->get<TriangleMesh>(geomID(i))->vertices0);
       const vfloat4 v0 = vfloat4::loadu(vertices + v0_[i]);
       const vfloat4 v1 = vfloat4::loadu(vertices + v1_[i]);
       const vfloat4 v2 = vfloat4::loadu(vertices + v2_[i]);
@@ -314,12 +314,30 @@ namespace embree
 
     __forceinline Triangle loadTriangle(const int i, const int itime, const TriangleMesh* const mesh) const 
     {
+      if (unlikely(mesh->vertices0.isCompressed()))
+        return loadCompressedTriangle(i,mesh->vertices[itime]);
       const float* vertices = (const float*) mesh->vertexPtr(0,itime);
       const vfloat4 v0 = vfloat4::loadu(vertices + v0_[i]);
       const vfloat4 v1 = vfloat4::loadu(vertices + v1_[i]);
       const vfloat4 v2 = vfloat4::loadu(vertices + v2_[i]);
       return { v0, v1, v2 };
     }
+
+    /* half precision and quantized vertices are addressed by vertex index and decoded when loaded */
+    __forceinline Triangle loadCompressedTriangle(const int i, const BufferView<Vec3fa>& vertices) const
+    {
+      const vfloat4 v0 = (vfloat4) vertices[v0_[i]];
+      const vfloat4 v1 = (vfloat4) vertices[v1_[i]];
+      const vfloat4 v2 = (vfloat4) vertices[v2_[i]];
+      return { v0, v1, v2 };
+    }
+
+    static __forceinline Vec3fa loadVertex(const TriangleMesh* const mesh, const size_t itime, const unsigned int offset)
+    {
+      if (unlikely(mesh->vertices0.isCompressed()))
+        return mesh->vertices[itime][offset];
+      return Vec3fa::loadu((const float*)mesh->vertexPtr(0,itime) + offset);
+    }
     
 #endif
 
@@ -0,0 +1,121 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Precalculated representation for M triangles. Stores for each
+     triangle the affine transformation from world space into the space
+     of the unit triangle (0,0,0), (1,0,0), (0,1,0), such that the
+     intersection test only requires transforming the ray (Woop's
+     unit triangle test). The rows of the transformation yield the
+     barycentric u and v coordinates and the coordinate along the
+     geometry normal, which is zero on the triangle plane. */
+  template<int M>
+  struct TriangleMw
+  {
+  public:
+    struct Type : public PrimitiveType
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximum number of stored triangles */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+  public:
+
+    /* Default constructor */
+    __forceinline TriangleMw() {}
+
+    /* Construction from vertices and IDs */
+    __forceinline TriangleMw(const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const vuint<M>& geomIDs, const vuint<M>& primIDs)
+      : geomIDs(geomIDs), primIDs(primIDs)
+    {
+      /* the inverse of the matrix with columns e1, e2, and Ng has
+         the rows cross(e2,Ng), cross(Ng,e1), and Ng divided by the
+         determinant dot(Ng,Ng) */
+      const Vec3vf<M> e1 = v1-v0;
+      const Vec3vf<M> e2 = v2-v0;
+      const Vec3vf<M> Ng = cross(e1,e2);
+      const vfloat<M> det = dot(Ng,Ng);
+      const vbool<M> valid = det != vfloat<M>(zero);
+      const vfloat<M> rcp_det = select(valid,vfloat<M>(one)/det,vfloat<M>(zero));
+      U = cross(e2,Ng)*rcp_det; ou = -dot(U,v0);
+      V = cross(Ng,e1)*rcp_det; ov = -dot(V,v0);
+      N = Ng*rcp_det;           on = -dot(N,v0);
+    }
+
+    /* Returns a mask that tells which triangles are valid */
+    __forceinline vbool<M> valid() const { return geomIDs != vuint<M>(-1); }
+
+    /* Returns true if the specified triangle is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return geomIDs[i] != -1; }
+
+    /* Returns the number of stored triangles */
+    __forceinline size_t size() const { return bsf(~movemask(valid()));  }
+
+    /* Returns the geometry IDs */
+    __forceinline       vuint<M>& geomID()       { return geomIDs;  }
+    __forceinline const vuint<M>& geomID() const { return geomIDs;  }
+    __forceinline unsigned int geomID(const size_t i) const { assert(i<M); return geomIDs[i]; }
+
+    /* Returns the primitive IDs */
+    __forceinline       vuint<M>& primID()       { return primIDs; }
+    __forceinline const vuint<M>& primID() const { return primIDs; }
+    __forceinline unsigned int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* Fill triangle from triangle list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene)
+    {
+      vuint<M> vgeomID = -1, vprimID = -1;
+      Vec3vf<M> v0 = zero, v1 = zero, v2 = zero;
+
+      for (size_t i=0; i<M && begin<end; i++, begin++)
+      {
+	const PrimRef& prim = prims[begin];
+        const unsigned geomID = prim.geomID();
+        const unsigned primID = prim.primID();
+        const TriangleMesh* __restrict__ const mesh = scene->get<TriangleMesh>(geomID);
+        const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+        const Vec3fa& p0 = mesh->vertex(tri.v[0]);
+        const Vec3fa& p1 = mesh->vertex(tri.v[1]);
+        const Vec3fa& p2 = mesh->vertex(tri.v[2]);
+        vgeomID [i] = geomID;
+        vprimID [i] = primID;
+        v0.x[i] = p0.x; v0.y[i] = p0.y; v0.z[i] = p0.z;
+        v1.x[i] = p1.x; v1.y[i] = p1.y; v1.z[i] = p1.z;
+        v2.x[i] = p2.x; v2.y[i] = p2.y; v2.z[i] = p2.z;
+      }
+      new (this) TriangleMw(v0,v1,v2,vgeomID,vprimID);
+    }
+
+  public:
+    Vec3vf<M> U;     // row of the transformation that yields the barycentric u coordinate
+    Vec3vf<M> V;     // row of the transformation that yields the barycentric v coordinate
+    Vec3vf<M> N;     // row of the transformation that yields the normal coordinate (Ng/dot(Ng,Ng))
+    vfloat<M> ou;    // translation of the u row
+    vfloat<M> ov;    // translation of the v row
+    vfloat<M> on;    // translation of the normal row
+  private:
+    vuint<M> geomIDs; // geometry IDs
+    vuint<M> primIDs; // primitive IDs
+  };
+
+  template<int M>
+  typename TriangleMw<M>::Type TriangleMw<M>::type;
+
+  typedef TriangleMw<4> Triangle4w;
+}
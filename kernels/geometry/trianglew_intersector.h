@@ -0,0 +1,231 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "trianglew.h"
+#include "intersector_epilog.h"
+
+/*! This intersector implements Woop's unit triangle test, which
+ *  transforms the ray into the space of the unit triangle using the
+ *  affine transformation precalculated in the TriangleMw leaves. */
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int M>
+    struct WoopUnitHitM
+    {
+      __forceinline WoopUnitHitM() {}
+
+      __forceinline WoopUnitHitM(const vbool<M>& valid, const vfloat<M>& U, const vfloat<M>& V, const vfloat<M>& T, const Vec3vf<M>& N)
+        : U(U), V(V), T(T), N(N), valid(valid) {}
+
+      __forceinline void finalize()
+      {
+        vt = T;
+        vu = U;
+        vv = V;
+        vNg = N*rcp(dot(N,N));
+      }
+
+      __forceinline Vec2f uv (const size_t i) const { return Vec2f(vu[i],vv[i]); }
+      __forceinline float t  (const size_t i) const { return vt[i]; }
+      __forceinline Vec3fa Ng(const size_t i) const { return Vec3fa(vNg.x[i],vNg.y[i],vNg.z[i]); }
+
+    private:
+      vfloat<M> U;
+      vfloat<M> V;
+      vfloat<M> T;
+      Vec3vf<M> N;
+
+    public:
+      vbool<M> valid;
+      vfloat<M> vu;
+      vfloat<M> vv;
+      vfloat<M> vt;
+      Vec3vf<M> vNg;
+    };
+
+    template<int K>
+    struct WoopUnitHitK
+    {
+      __forceinline WoopUnitHitK(const vfloat<K>& U, const vfloat<K>& V, const vfloat<K>& T, const Vec3vf<K>& N)
+        : U(U), V(V), T(T), N(N) {}
+
+      __forceinline std::tuple<vfloat<K>,vfloat<K>,vfloat<K>,Vec3vf<K>> operator() () const {
+        return std::make_tuple(U,V,T,N*rcp(dot(N,N)));
+      }
+
+    private:
+      const vfloat<K> U;
+      const vfloat<K> V;
+      const vfloat<K> T;
+      const Vec3vf<K> N;
+    };
+
+    /*! Intersects a ray with the M triangles stored in the transformed
+     *  representation. The ray is transformed by the normal row first,
+     *  to reject triangles early by the depth test. */
+    template<int M>
+    __forceinline bool intersectWoopUnit(const vbool<M>& valid0,
+                                         const Vec3vf<M>& org, const Vec3vf<M>& dir,
+                                         const vfloat<M>& tnear, const vfloat<M>& tfar,
+                                         const TriangleMw<M>& tri, WoopUnitHitM<M>& hit)
+    {
+      /* intersect ray with the triangle plane */
+      const vfloat<M> Dn = dot(tri.N,dir);
+      const vfloat<M> On = dot(tri.N,org) + tri.on;
+      const vfloat<M> T = -On/Dn;
+#if defined(EMBREE_BACKFACE_CULLING)
+      vbool<M> valid = valid0 & (Dn < vfloat<M>(zero)) & (tnear < T) & (T <= tfar);
+#else
+      vbool<M> valid = valid0 & (Dn != vfloat<M>(zero)) & (tnear < T) & (T <= tfar);
+#endif
+      if (likely(none(valid))) return false;
+
+      /* calculate barycentric coordinates of the hit point */
+      const vfloat<M> U = madd(T,dot(tri.U,dir),dot(tri.U,org) + tri.ou);
+      const vfloat<M> V = madd(T,dot(tri.V,dir),dot(tri.V,org) + tri.ov);
+      valid &= (U >= 0.0f) & (V >= 0.0f) & (U+V <= 1.0f);
+      if (likely(none(valid))) return false;
+
+      new (&hit) WoopUnitHitM<M>(valid,U,V,T,tri.N);
+      return true;
+    }
+
+    /*! Intersects K rays with one of the M triangles stored in the
+     *  transformed representation. */
+    template<int M, int K, typename Epilog>
+    __forceinline vbool<K> intersectWoopUnitK(const vbool<K>& valid0, RayK<K>& ray, const TriangleMw<M>& tri, size_t i, const Epilog& epilog)
+    {
+      const Vec3vf<K> N = broadcast<vfloat<K>>(tri.N,i);
+      const vfloat<K> Dn = dot(N,ray.dir);
+      const vfloat<K> On = dot(N,ray.org) + vfloat<K>(tri.on[i]);
+      const vfloat<K> T = -On/Dn;
+#if defined(EMBREE_BACKFACE_CULLING)
+      vbool<K> valid = valid0 & (Dn < vfloat<K>(zero)) & (ray.tnear() < T) & (T <= ray.tfar);
+#else
+      vbool<K> valid = valid0 & (Dn != vfloat<K>(zero)) & (ray.tnear() < T) & (T <= ray.tfar);
+#endif
+      if (likely(none(valid))) return false;
+
+      const Vec3vf<K> Ur = broadcast<vfloat<K>>(tri.U,i);
+      const Vec3vf<K> Vr = broadcast<vfloat<K>>(tri.V,i);
+      const vfloat<K> U = madd(T,dot(Ur,ray.dir),dot(Ur,ray.org) + vfloat<K>(tri.ou[i]));
+      const vfloat<K> V = madd(T,dot(Vr,ray.dir),dot(Vr,ray.org) + vfloat<K>(tri.ov[i]));
+      valid &= (U >= 0.0f) & (V >= 0.0f) & (U+V <= 1.0f);
+      if (likely(none(valid))) return false;
+
+      return epilog(valid,WoopUnitHitK<K>(U,V,T,N));
+    }
+
+    /*! Precalculations of the unit triangle test, nothing is precalculated per ray. */
+    struct WoopUnitPrecalculations1
+    {
+      __forceinline WoopUnitPrecalculations1() {}
+      __forceinline WoopUnitPrecalculations1(const Ray& ray, const void* ptr) {}
+    };
+
+    template<int K>
+    struct WoopUnitPrecalculationsK
+    {
+      __forceinline WoopUnitPrecalculationsK(const vbool<K>& valid, const RayK<K>& ray) {}
+    };
+
+    /*! Intersects M triangles with 1 ray */
+    template<int M, bool filter>
+    struct TriangleMwIntersector1Woop
+    {
+      typedef TriangleMw<M> Primitive;
+      typedef WoopUnitPrecalculations1 Precalculations;
+
+      /*! Intersect a ray with the M triangles and updates the hit. */
+      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, RayQueryContext* context, const TriangleMw<M>& tri)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        WoopUnitHitM<M> hit;
+        const Vec3vf<M> org(ray.org.x,ray.org.y,ray.org.z);
+        const Vec3vf<M> dir(ray.dir.x,ray.dir.y,ray.dir.z);
+        if (intersectWoopUnit<M>(tri.valid(),org,dir,vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),tri,hit))
+          Intersect1EpilogM<M,filter>(ray,context,tri.geomID(),tri.primID())(hit.valid,hit);
+      }
+
+      /*! Test if the ray is occluded by one of M triangles. */
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, RayQueryContext* context, const TriangleMw<M>& tri)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        WoopUnitHitM<M> hit;
+        const Vec3vf<M> org(ray.org.x,ray.org.y,ray.org.z);
+        const Vec3vf<M> dir(ray.dir.x,ray.dir.y,ray.dir.z);
+        if (intersectWoopUnit<M>(tri.valid(),org,dir,vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),tri,hit))
+          return Occluded1EpilogM<M,filter>(ray,context,tri.geomID(),tri.primID())(hit.valid,hit);
+        return false;
+      }
+
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+      }
+    };
+
+    /*! Intersects M triangles with K rays. */
+    template<int M, int K, bool filter>
+    struct TriangleMwIntersectorKWoop
+    {
+      typedef TriangleMw<M> Primitive;
+      typedef WoopUnitPrecalculationsK<K> Precalculations;
+
+      /*! Intersects K rays with M triangles. */
+      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, RayQueryContext* context, const TriangleMw<M>& tri)
+      {
+        STAT_USER(0,TriangleMw<M>::max_size());
+        for (size_t i=0; i<TriangleMw<M>::max_size(); i++)
+        {
+          if (!tri.valid(i)) break;
+          STAT3(normal.trav_prims,1,popcnt(valid_i),K);
+          intersectWoopUnitK<M,K>(valid_i,ray,tri,i,IntersectKEpilogM<M,K,filter>(ray,context,tri.geomID(),tri.primID(),i));
+        }
+      }
+
+      /*! Test for K rays if they are occluded by any of the M triangles. */
+      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, RayQueryContext* context, const TriangleMw<M>& tri)
+      {
+        vbool<K> valid0 = valid_i;
+
+        for (size_t i=0; i<TriangleMw<M>::max_size(); i++)
+        {
+          if (!tri.valid(i)) break;
+          STAT3(shadow.trav_prims,1,popcnt(valid0),K);
+          intersectWoopUnitK<M,K>(valid0,ray,tri,i,OccludedKEpilogM<M,K,filter>(valid0,ray,context,tri.geomID(),tri.primID(),i));
+          if (none(valid0)) break;
+        }
+        return !valid0;
+      }
+
+      /*! Intersect a ray with M triangles and updates the hit. */
+      static __forceinline void intersect(Precalculations& pre, RayHitK<K>& ray, size_t k, RayQueryContext* context, const TriangleMw<M>& tri)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        WoopUnitHitM<M> hit;
+        const Vec3vf<M> org = broadcast<vfloat<M>>(ray.org,k);
+        const Vec3vf<M> dir = broadcast<vfloat<M>>(ray.dir,k);
+        if (intersectWoopUnit<M>(tri.valid(),org,dir,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),tri,hit))
+          Intersect1KEpilogM<M,K,filter>(ray,k,context,tri.geomID(),tri.primID())(hit.valid,hit);
+      }
+
+      /*! Test if the ray is occluded by one of the M triangles. */
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, RayQueryContext* context, const TriangleMw<M>& tri)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        WoopUnitHitM<M> hit;
+        const Vec3vf<M> org = broadcast<vfloat<M>>(ray.org,k);
+        const Vec3vf<M> dir = broadcast<vfloat<M>>(ray.dir,k);
+        if (intersectWoopUnit<M>(tri.valid(),org,dir,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),tri,hit))
+          return Occluded1KEpilogM<M,K,filter>(ray,k,context,tri.geomID(),tri.primID())(hit.valid,hit);
+        return false;
+      }
+    };
+  }
+}
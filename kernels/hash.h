@@ -0,0 +1,4 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#define RTC_HASH "79320e5903e15f799de2eecff12d997f5d27ab42"
@@ -73,7 +73,12 @@ if ${RUN_BUILD_BENCHMARKS}; then
     if [[ $NAME == '#'* ]]; then
       continue
     fi
-    SCENE=${MODEL_DIR}/"${array[1]}"
+    # a scene path of "-" benchmarks scenes generated from command line options only
+    if [[ "${array[1]}" == "-" ]]; then
+      SCENE=""
+    else
+      SCENE="-i ${MODEL_DIR}/${array[1]}"
+    fi
 
     unset "array[0]"
     unset "array[1]"
@@ -85,8 +90,8 @@ if ${RUN_BUILD_BENCHMARKS}; then
 
       initContext
 
-      echo "${NUMACTL} ./buildbench --benchmark_out=results-${SUITE_NAME}-${SUBSUITE_NAME}.json ${BENCHMARK} --benchmark_type ${SUBSUITE_NAME} -i ${SCENE} ${array[@]} ${THREADS}"
-      ${NUMACTL} ./buildbench --benchmark_out=results-${SUITE_NAME}-${SUBSUITE_NAME}.json ${BENCHMARK} --benchmark_type ${SUBSUITE_NAME} -i ${SCENE} ${array[@]} ${THREADS}
+      echo "${NUMACTL} ./buildbench --benchmark_out=results-${SUITE_NAME}-${SUBSUITE_NAME}.json ${BENCHMARK} --benchmark_type ${SUBSUITE_NAME} ${SCENE} ${array[@]} ${THREADS}"
+      ${NUMACTL} ./buildbench --benchmark_out=results-${SUITE_NAME}-${SUBSUITE_NAME}.json ${BENCHMARK} --benchmark_type ${SUBSUITE_NAME} ${SCENE} ${array[@]} ${THREADS}
       benny insert googlebenchmark ./run_context.json ${SUITE_NAME} ${SUBSUITE_NAME} ./results-${SUITE_NAME}-${SUBSUITE_NAME}.json
     done
   done < "${BUILD_SCENES_FILE}"
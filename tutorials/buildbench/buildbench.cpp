@@ -84,6 +84,9 @@ namespace embree
       if (buildParams.buildBenchType & BuildBenchType::CREATE_HIGH_QUALITY_STATIC_STATIC) {
         Benchmark_Static_Create(state, params, buildParams, tutorial->ispc_scene.get(), RTC_BUILD_QUALITY_MEDIUM,RTC_BUILD_QUALITY_HIGH);
       }
+      if (buildParams.buildBenchType & BuildBenchType::CREATE_OBJECTS_STATIC_STATIC) {
+        Benchmark_Objects_Create(state, params, buildParams, tutorial->ispc_scene.get(), RTC_BUILD_QUALITY_MEDIUM);
+      }
     }
     else
     {
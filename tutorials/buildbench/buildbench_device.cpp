@@ -100,28 +100,30 @@ namespace embree {
     return scene_out;
   }
 
+  void convertGeometry(ISPCGeometry* geometry, RTCScene scene_out, RTCBuildQuality quality)
+  {
+    if (geometry->type == SUBDIV_MESH) {
+      convertSubdivMesh((ISPCSubdivMesh*) geometry, scene_out, quality);
+    }
+    else if (geometry->type == TRIANGLE_MESH) {
+      convertTriangleMesh((ISPCTriangleMesh*) geometry, scene_out, quality);
+    }
+    else if (geometry->type == QUAD_MESH) {
+      convertQuadMesh((ISPCQuadMesh*) geometry, scene_out, quality);
+    }
+    else if (geometry->type == CURVES) {
+      convertCurveGeometry((ISPCHairSet*) geometry, scene_out, quality);
+    }
+    else
+      assert(false);
+  }
+
   void convertScene(RTCScene scene_out, ISPCScene* scene_in, RTCBuildQuality quality)
   {
     size_t numGeometries = scene_in->numGeometries;
 
     for (size_t i=0; i<numGeometries; i++)
-    {
-      ISPCGeometry* geometry = scene_in->geometries[i];
-      if (geometry->type == SUBDIV_MESH) {
-        convertSubdivMesh((ISPCSubdivMesh*) geometry, scene_out, quality);
-      }
-      else if (geometry->type == TRIANGLE_MESH) {
-        convertTriangleMesh((ISPCTriangleMesh*) geometry, scene_out, quality);
-      }
-      else if (geometry->type == QUAD_MESH) {
-        convertQuadMesh((ISPCQuadMesh*) geometry, scene_out, quality);
-      }
-      else if (geometry->type == CURVES) {
-        convertCurveGeometry((ISPCHairSet*) geometry, scene_out, quality);
-      }
-      else
-        assert(false);
-    }
+      convertGeometry(scene_in->geometries[i], scene_out, quality);
   }
   
   size_t getNumPrimitives(ISPCScene* scene_in)
@@ -463,6 +465,93 @@ namespace embree {
     Benchmark_Static_Create_Legacy(ispc_scene, params, quality, qflags);
 #endif
   }
+  /* creates a separate scene for each object and measures the latency of a single commit */
+  void Benchmark_Objects_Create_Legacy(ISPCScene* scene_in, BenchParams& params, RTCBuildQuality quality)
+  {
+    size_t benchmark_iterations = params.minTimeOrIterations;
+    if (benchmark_iterations <= 0)
+      benchmark_iterations = iterations_static_static;
+
+    size_t primitives = getNumPrimitives(scene_in);
+    size_t objects = getNumObjects(scene_in);
+    size_t iterations = 0;
+    double time = 0.0;
+
+    std::vector<RTCScene> scenes(objects);
+    for(size_t i=0;i<benchmark_iterations+params.skipIterations;i++)
+    {
+      for (size_t j=0; j<objects; j++) {
+        scenes[j] = createScene(RTC_SCENE_FLAG_NONE,quality);
+        convertGeometry(scene_in->geometries[j],scenes[j],quality);
+      }
+
+      double t0 = getSeconds();
+      for (size_t j=0; j<objects; j++)
+        rtcCommitScene (scenes[j]);
+      double t1 = getSeconds();
+      if (i >= params.skipIterations)
+      {
+        time += t1 - t0;
+        iterations++;
+      }
+
+      for (size_t j=0; j<objects; j++)
+        rtcReleaseScene (scenes[j]);
+    }
+
+    if (iterations == 0) iterations = 1;
+    if (objects == 0) objects = 1;
+    std::cout << "BENCHMARK_CREATE_OBJECTS_STATIC_STATIC ";
+    std::cout << iterations << " iterations, " << primitives << " primitives, " << objects << " objects, "
+              << time/iterations << " s, "
+              << 1E6 * time/(iterations*objects) << " us/commit" << std::endl;
+  }
+
+  void Benchmark_Objects_Create(
+    BenchState& state, 
+    BenchParams& params, 
+    BuildBenchParams& buildParams, 
+    ISPCScene* ispc_scene, 
+    RTCBuildQuality quality)
+  {
+#ifdef USE_GOOGLE_BENCHMARK
+    if (params.legacy) {
+      Benchmark_Objects_Create_Legacy(ispc_scene, params, quality);
+      return;
+    }
+
+    const size_t primitives = getNumPrimitives(ispc_scene);
+    const size_t objects = getNumObjects(ispc_scene);
+    std::vector<RTCScene> scenes(objects);
+
+    for(auto _ : *state.state) {
+      state.state->PauseTiming();
+
+      for (size_t j=0; j<objects; j++) {
+        scenes[j] = createScene(RTC_SCENE_FLAG_NONE, quality);
+        convertGeometry(ispc_scene->geometries[j], scenes[j], quality);
+      }
+
+      state.state->ResumeTiming();
+
+      for (size_t j=0; j<objects; j++)
+        rtcCommitScene(scenes[j]);
+
+      state.state->PauseTiming();
+
+      for (size_t j=0; j<objects; j++)
+        rtcReleaseScene(scenes[j]);
+
+      state.state->ResumeTiming();
+    }
+
+    addCounter(state, primitives, objects);
+    state.state->counters["CommitTime"] = ::benchmark::Counter(double(objects), ::benchmark::Counter::kIsIterationInvariantRate | ::benchmark::Counter::kInvert);
+#else
+    Benchmark_Objects_Create_Legacy(ispc_scene, params, quality);
+#endif
+  }
+
   struct Helper {
     BarrierSys barrier;
     volatile bool term = false;
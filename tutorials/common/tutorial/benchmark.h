@@ -22,7 +22,8 @@ enum BuildBenchType {
   CREATE_STATIC_STATIC = 64,
   CREATE_HIGH_QUALITY_STATIC_STATIC = 128,
   CREATE_USER_THREADS_STATIC_STATIC = 256,
-  ALL = 511
+  CREATE_OBJECTS_STATIC_STATIC = 512,
+  ALL = 1023
 };
 
 static MAYBE_UNUSED BuildBenchType getBuildBenchType(std::string const& str)
@@ -36,6 +37,7 @@ static MAYBE_UNUSED BuildBenchType getBuildBenchType(std::string const& str)
   else if (str == "create_static_static")              return BuildBenchType::CREATE_STATIC_STATIC;
   else if (str == "create_high_quality_static_static") return BuildBenchType::CREATE_HIGH_QUALITY_STATIC_STATIC;
   else if (str == "create_user_threads_static_static") return BuildBenchType::CREATE_USER_THREADS_STATIC_STATIC;
+  else if (str == "create_objects_static_static")      return BuildBenchType::CREATE_OBJECTS_STATIC_STATIC;
   return BuildBenchType::ALL;
 }
 
@@ -50,6 +52,7 @@ static MAYBE_UNUSED std::string getBuildBenchTypeString(BuildBenchType type)
   else if (type == BuildBenchType::CREATE_STATIC_STATIC)              return "create_static_static";
   else if (type == BuildBenchType::CREATE_HIGH_QUALITY_STATIC_STATIC) return "create_high_quality_static_static";
   else if (type == BuildBenchType::CREATE_USER_THREADS_STATIC_STATIC) return "create_user_threads_static_static";
+  else if (type == BuildBenchType::CREATE_OBJECTS_STATIC_STATIC)      return "create_objects_static_static";
   return "all";
 }
 
@@ -14,6 +14,7 @@
 #include "../../kernels/common/scene.h"
 #include <regex>
 #include <stack>
+#include <thread>
 
 #define random  use_random_function_of_test // do use random_int() and random_float() from Test class
 #define drand48 use_random_function_of_test // do use random_int() and random_float() from Test class
@@ -1306,6 +1307,414 @@ namespace embree
     }
   };
 
+  struct MixedAccelTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    MixedAccelTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      std::string cfg1 = cfg + ",mixed_accel=1";
+      RTCDeviceRef device1 = rtcNewDevice(cfg1.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+      VerifyScene scene0(device0,sflags);
+      VerifyScene scene1(device1,sflags);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      Ref<SceneGraph::Node> hair = SceneGraph::createHairyPlane(RandomSampler_getInt(sampler),Vec3fa(-1,-1,-1),Vec3fa(2,0,0),Vec3fa(0,2,0),0.2f,0.01f,1000,SceneGraph::FLAT_CURVE);
+      std::vector<Ref<SceneGraph::Node>> nodes;
+      nodes.push_back(SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),0.5f,50));
+      nodes.push_back(SceneGraph::createQuadSphere(Vec3fa(+1,0,0),0.5f,50));
+      nodes.push_back(SceneGraph::convert_bezier_to_lines(hair));
+
+      for (auto& node : nodes) {
+        scene0.addGeometry(sflags.qflags,node);
+        scene1.addGeometry(sflags.qflags,node);
+      }
+      rtcCommitScene (scene0);
+      AssertNoError(device0);
+      rtcCommitScene (scene1);
+      AssertNoError(device1);
+
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+        const Vec3fa dir = 4.0f*random_Vec3fa()-Vec3fa(2.0f)-org;
+        RTCRayHit ray0 = makeRay(org,dir);
+        RTCRayHit ray1 = makeRay(org,dir);
+        rtcIntersect1(scene0,&ray0);
+        rtcIntersect1(scene1,&ray1);
+        if ((ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID) != (ray1.hit.geomID == RTC_INVALID_GEOMETRY_ID)) return VerifyApplication::FAILED;
+        if (ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (abs(ray0.ray.tfar-ray1.ray.tfar) > 1E-4f*max(1.0f,ray0.ray.tfar)) return VerifyApplication::FAILED;
+
+        /* primitives sharing a vertex or edge may both report the closest hit */
+        if (ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID)
+          if (ray0.ray.tfar != ray1.ray.tfar) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct MultiHitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    MultiHitTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+
+      scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(-2,0,0),0.5f,50));
+      scene.addGeometry(sflags.qflags,SceneGraph::createQuadSphere(Vec3fa(0,0,0),0.5f,50));
+      scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(+2,0,0),0.5f,50));
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org(-4.0f,0.8f*RandomSampler_get1D(sampler)-0.4f,0.8f*RandomSampler_get1D(sampler)-0.4f);
+        const Vec3fa dir(1.0f,0.0f,0.0f);
+
+        /* gather reference hits by repeated closest hit queries */
+        std::vector<float> ref;
+        float tnear = 0.0f;
+        while (ref.size() < RTC_MAX_MULTI_HIT_COUNT)
+        {
+          RTCRayHit ray = makeRay(org,dir,tnear,inf);
+          rtcIntersect1(scene,&ray);
+          if (ray.hit.geomID == RTC_INVALID_GEOMETRY_ID) break;
+          ref.push_back(ray.ray.tfar);
+          tnear = ray.ray.tfar + 1E-3f;
+        }
+
+        for (unsigned int maxHits : { 1u, 2u, (unsigned int)RTC_MAX_MULTI_HIT_COUNT })
+        {
+          RTCRayMultiHit mray;
+          mray.ray = makeRay(org,dir).ray;
+          mray.maxHitCount = maxHits;
+          rtcIntersectMultiHit(scene,&mray);
+          AssertNoError(device);
+
+          /* every reference hit has to be found and hits have to be sorted */
+          if (mray.hitCount < min(size_t(maxHits),ref.size())) return VerifyApplication::FAILED;
+          for (size_t j=1; j<mray.hitCount; j++)
+            if (mray.tfar[j] < mray.tfar[j-1]) return VerifyApplication::FAILED;
+          for (size_t j=0, k=0; j<min(size_t(maxHits),ref.size()); j++) {
+            while (k<mray.hitCount && mray.tfar[k] < ref[j]-1E-4f) k++;
+            if (k == mray.hitCount || abs(mray.tfar[k]-ref[j]) > 1E-4f) return VerifyApplication::FAILED;
+          }
+        }
+      }
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TransmittanceTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    TransmittanceTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+
+      /* four semi-transparent planes followed by an opaque plane covering half of the rays */
+      std::vector<float> opacity(32,0.5f);
+      for (size_t i=0; i<4; i++) {
+        unsigned int geomID = scene.addPlane(sampler,sflags.qflags,4,Vec3fa(float(i),-1,-1),Vec3fa(0,2,0),Vec3fa(0,0,2)).first;
+        if (i < 2) rtcSetGeometryOpacity(rtcGetGeometry(scene,geomID),0.5f);
+        else       rtcSetGeometryOpacityBuffer(rtcGetGeometry(scene,geomID),opacity.data());
+      }
+      scene.addPlane(sampler,sflags.qflags,1,Vec3fa(5,0,-1),Vec3fa(0,1,0),Vec3fa(0,0,2));
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<256; i++)
+      {
+        RTCRayHit rays[16];
+        for (size_t j=0; j<16; j++) {
+          const Vec3fa org(-1.0f,1.8f*RandomSampler_get1D(sampler)-0.9f,1.8f*RandomSampler_get1D(sampler)-0.9f);
+          rays[j] = makeRay(org,Vec3fa(1,0,0));
+        }
+        const float minTransmittance = ((i/4)%2) ? 0.01f : 0.1f;
+        __aligned(64) float T[16];
+        for (size_t j=0; j<16; j++) T[j] = 1.0f;
+
+        switch (i%4) {
+        case 0: for (size_t j=0; j<16; j++) rtcTransmittance1(scene,&rays[j].ray,&T[j],minTransmittance); break;
+        case 1: {
+          for (size_t j=0; j<16; j+=4) {
+            __aligned(16) int valid[4] = { -1,-1,-1,-1 };
+            __aligned(16) RTCRayHit4 ray4;
+            for (size_t k=0; k<4; k++) setRay(ray4,k,rays[j+k]);
+            rtcTransmittance4(valid,scene,(RTCRay4*)&ray4,&T[j],minTransmittance);
+            for (size_t k=0; k<4; k++) rays[j+k] = getRay(ray4,k);
+          }
+          break;
+        }
+        case 2: {
+          for (size_t j=0; j<16; j+=8) {
+            __aligned(32) int valid[8] = { -1,-1,-1,-1,-1,-1,-1,-1 };
+            __aligned(32) RTCRayHit8 ray8;
+            for (size_t k=0; k<8; k++) setRay(ray8,k,rays[j+k]);
+            rtcTransmittance8(valid,scene,(RTCRay8*)&ray8,&T[j],minTransmittance);
+            for (size_t k=0; k<8; k++) rays[j+k] = getRay(ray8,k);
+          }
+          break;
+        }
+        case 3: {
+          __aligned(64) int valid[16];
+          __aligned(64) RTCRayHit16 ray16;
+          for (size_t k=0; k<16; k++) { valid[k] = -1; setRay(ray16,k,rays[k]); }
+          rtcTransmittance16(valid,scene,(RTCRay16*)&ray16,T,minTransmittance);
+          for (size_t k=0; k<16; k++) rays[k] = getRay(ray16,k);
+          break;
+        }
+        }
+        AssertNoError(device);
+
+        for (size_t j=0; j<16; j++)
+        {
+          const bool opaque = rays[j].ray.org_y > 0.0f;
+          const bool occluded = rays[j].ray.tfar < 0.0f;
+          if (opaque || minTransmittance > 0.0625f) {
+            if (!occluded) return VerifyApplication::FAILED;
+          } else {
+            if (occluded) return VerifyApplication::FAILED;
+            if (abs(T[j]-0.0625f) > 1E-5f) return VerifyApplication::FAILED;
+          }
+        }
+      }
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CompressedVerticesTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+    RTCFormat format;
+    RTCFormat iformat;
+
+    CompressedVerticesTest (std::string name, int isa, SceneFlags sflags, RTCGeometryType gtype, RTCFormat format, RTCFormat iformat)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype), format(format), iformat(iformat) {}
+
+    /* converts floats that are exactly representable in half precision */
+    static unsigned short toHalf(float f)
+    {
+      const unsigned int i = *(unsigned int*)&f;
+      const unsigned short sign = (i >> 16) & 0x8000;
+      if ((i & 0x7fffffff) == 0) return sign;
+      return sign | (((i >> 23) & 0xff) - 127 + 15) << 10 | ((i >> 13) & 0x3ff);
+    }
+
+    /* creates a height field of quads or triangles */
+    RTCGeometry createGeometry(RTCDevice device, RTCFormat vformat, RTCFormat iformat, const std::vector<short>& quantized, const std::vector<float>& positions, size_t N)
+    {
+      RTCGeometry geom = rtcNewGeometry(device,gtype);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+      const size_t numVertices = (N+1)*(N+1);
+      if (vformat == RTC_FORMAT_FLOAT3) {
+        float* vertices = (float*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,3*sizeof(float),numVertices);
+        for (size_t i=0; i<3*numVertices; i++) vertices[i] = positions[i];
+      }
+      else if (vformat == RTC_FORMAT_HALF3) {
+        unsigned short* vertices = (unsigned short*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_HALF3,3*sizeof(short),numVertices);
+        for (size_t i=0; i<3*numVertices; i++) vertices[i] = toHalf(positions[i]);
+      }
+      else {
+        short* vertices = (short*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_SHORT3,3*sizeof(short),numVertices);
+        for (size_t i=0; i<3*numVertices; i++) vertices[i] = quantized[i];
+        const float scale[3] = { 0.125f, 0.125f, 0.125f };
+        const float offset[3] = { 0.5f, -1.0f, 0.25f };
+        rtcSetGeometryVertexQuantization(geom,scale,offset);
+      }
+
+      std::vector<unsigned int> indices;
+      if (gtype == RTC_GEOMETRY_TYPE_QUAD) {
+        indices.resize(4*N*N);
+        for (size_t y=0; y<N; y++) {
+          for (size_t x=0; x<N; x++) {
+            unsigned int* quad = &indices[4*(y*N+x)];
+            quad[0] = (unsigned int)((y+0)*(N+1)+x+0);
+            quad[1] = (unsigned int)((y+0)*(N+1)+x+1);
+            quad[2] = (unsigned int)((y+1)*(N+1)+x+1);
+            quad[3] = (unsigned int)((y+1)*(N+1)+x+0);
+          }
+        }
+      }
+      else {
+        indices.resize(6*N*N);
+        for (size_t y=0; y<N; y++) {
+          for (size_t x=0; x<N; x++) {
+            unsigned int* tri = &indices[6*(y*N+x)];
+            tri[0] = (unsigned int)((y+0)*(N+1)+x+0);
+            tri[1] = (unsigned int)((y+0)*(N+1)+x+1);
+            tri[2] = (unsigned int)((y+1)*(N+1)+x+1);
+            tri[3] = (unsigned int)((y+0)*(N+1)+x+0);
+            tri[4] = (unsigned int)((y+1)*(N+1)+x+1);
+            tri[5] = (unsigned int)((y+1)*(N+1)+x+0);
+          }
+        }
+      }
+
+      const size_t numIndices = gtype == RTC_GEOMETRY_TYPE_QUAD ? 4 : 3;
+      if (iformat == RTC_FORMAT_USHORT3 || iformat == RTC_FORMAT_USHORT4) {
+        unsigned short* buffer = (unsigned short*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,iformat,numIndices*sizeof(unsigned short),indices.size()/numIndices);
+        for (size_t i=0; i<indices.size(); i++) buffer[i] = (unsigned short) indices[i];
+      } else {
+        unsigned int* buffer = (unsigned int*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,iformat,numIndices*sizeof(unsigned int),indices.size()/numIndices);
+        for (size_t i=0; i<indices.size(); i++) buffer[i] = indices[i];
+      }
+      rtcCommitGeometry(geom);
+      return geom;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* quantized coordinates and the exactly representable positions they decode to */
+      const size_t N = 32;
+      std::vector<short> quantized(3*(N+1)*(N+1));
+      std::vector<float> positions(3*(N+1)*(N+1));
+      for (size_t y=0; y<=N; y++) {
+        for (size_t x=0; x<=N; x++) {
+          const size_t i = 3*(y*(N+1)+x);
+          quantized[i+0] = short(x)-short(N/2);
+          quantized[i+1] = short(8.0f*RandomSampler_get1D(sampler));
+          quantized[i+2] = short(y)-short(N/2);
+          positions[i+0] = 0.5f  + 0.125f*quantized[i+0];
+          positions[i+1] = -1.0f + 0.125f*quantized[i+1];
+          positions[i+2] = 0.25f + 0.125f*quantized[i+2];
+        }
+      }
+
+      VerifyScene scene0(device,sflags);
+      const RTCFormat iformat0 = gtype == RTC_GEOMETRY_TYPE_QUAD ? RTC_FORMAT_UINT4 : RTC_FORMAT_UINT3;
+      RTCGeometry geom0 = createGeometry(device,RTC_FORMAT_FLOAT3,iformat0,quantized,positions,N);
+      rtcAttachGeometry(scene0,geom0);
+      rtcCommitScene (scene0);
+      AssertNoError(device);
+
+      VerifyScene scene1(device,sflags);
+      RTCGeometry geom1 = createGeometry(device,format,iformat,quantized,positions,N);
+      rtcAttachGeometry(scene1,geom1);
+      rtcCommitScene (scene1);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t i=0; i<1000 && passed; i++)
+      {
+        const Vec3fa org(0.5f+2.0f*RandomSampler_get1D(sampler)-1.0f,4.0f,0.25f+2.0f*RandomSampler_get1D(sampler)-1.0f);
+        const Vec3fa dir(0.2f*RandomSampler_get1D(sampler)-0.1f,-1.0f,0.2f*RandomSampler_get1D(sampler)-0.1f);
+        RTCRayHit ray0 = makeRay(org,dir); rtcIntersect1(scene0,&ray0);
+        RTCRayHit ray1 = makeRay(org,dir); rtcIntersect1(scene1,&ray1);
+        passed &= ray0.hit.geomID == ray1.hit.geomID;
+        passed &= ray0.hit.primID == ray1.hit.primID;
+        passed &= abs(ray0.ray.tfar-ray1.ray.tfar) < 1E-4f;
+        passed &= abs(ray0.hit.u-ray1.hit.u) < 1E-4f;
+        passed &= abs(ray0.hit.v-ray1.hit.v) < 1E-4f;
+        if (!passed || ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+
+        /* interpolation has to decode the vertices */
+        float P0[3], P1[3];
+        rtcInterpolate0(geom0,ray0.hit.primID,ray0.hit.u,ray0.hit.v,RTC_BUFFER_TYPE_VERTEX,0,P0,3);
+        rtcInterpolate0(geom1,ray1.hit.primID,ray1.hit.u,ray1.hit.v,RTC_BUFFER_TYPE_VERTEX,0,P1,3);
+        for (size_t j=0; j<3; j++)
+          passed &= abs(P0[j]-P1[j]) < 1E-4f;
+      }
+      rtcReleaseGeometry(geom0);
+      rtcReleaseGeometry(geom1);
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct RefitRangeTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+
+    RefitRangeTest (std::string name, int isa, SceneFlags sflags, RTCGeometryType gtype)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      Ref<SceneGraph::Node> node;
+      if (gtype == RTC_GEOMETRY_TYPE_QUAD) node = SceneGraph::createQuadSphere(Vec3fa(0,0,0),1.0f,80);
+      else                                 node = SceneGraph::createTriangleSphere(Vec3fa(0,0,0),1.0f,80);
+      avector<Vec3fa>& positions = gtype == RTC_GEOMETRY_TYPE_QUAD ? node.dynamicCast<SceneGraph::QuadMeshNode>()->positions[0] : node.dynamicCast<SceneGraph::TriangleMeshNode>()->positions[0];
+
+      VerifyScene scene(device,sflags);
+      unsigned int geomID = scene.addGeometry(RTC_BUILD_QUALITY_REFIT,node);
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t stroke=0; stroke<4 && passed; stroke++)
+      {
+        /* move a small range of vertices outwards and update only that range */
+        const size_t count = positions.size()/20;
+        const size_t begin = RandomSampler_getInt(sampler) % (positions.size()-count);
+        for (size_t i=begin; i<begin+count; i++)
+          positions[i] = 1.2f*positions[i];
+        rtcUpdateGeometryBufferRange(geom,RTC_BUFFER_TYPE_VERTEX,0,begin,count);
+        rtcCommitGeometry(geom);
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        /* the refitted scene has to produce the same hits as a newly built scene */
+        VerifyScene reference(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+        reference.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+        rtcCommitScene (reference);
+        AssertNoError(device);
+
+        for (size_t i=0; i<1000 && passed; i++)
+        {
+          const Vec3fa org = 4.0f*normalize(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+          const Vec3fa dir = 0.6f*RandomSampler_get3D(sampler)-Vec3fa(0.3f)-org;
+          RTCRayHit ray0 = makeRay(org,dir); rtcIntersect1(scene,&ray0);
+          RTCRayHit ray1 = makeRay(org,dir); rtcIntersect1(reference,&ray1);
+          passed &= ray0.hit.geomID == ray1.hit.geomID;
+          passed &= ray0.ray.tfar == ray1.ray.tfar || abs(ray0.ray.tfar-ray1.ray.tfar) < 1E-4f;
+        }
+      }
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   static std::atomic<ssize_t> memory_consumption_bytes_used(0);
 
   struct MemoryConsumptionTest : public VerifyApplication::Test
@@ -1642,6 +2051,145 @@ namespace embree
     }
   };
 
+  struct BatchedCallbacksTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    struct Spheres
+    {
+      std::vector<Vec3fa> centers;
+      float radius;
+      unsigned int maxPrimCount;
+    };
+
+    BatchedCallbacksTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static void boundsFunc(const RTCBoundsFunctionArguments* args)
+    {
+      const Spheres* spheres = (const Spheres*) args->geometryUserPtr;
+      const Vec3fa& c = spheres->centers[args->primID];
+      const float r = spheres->radius;
+      RTCBounds* bounds = args->bounds_o;
+      bounds->lower_x = c.x-r; bounds->lower_y = c.y-r; bounds->lower_z = c.z-r;
+      bounds->upper_x = c.x+r; bounds->upper_y = c.y+r; bounds->upper_z = c.z+r;
+    }
+
+    static bool intersectSphere(const Spheres* spheres, unsigned int primID, const RTCRay& ray, float& t)
+    {
+      const Vec3fa org(ray.org_x,ray.org_y,ray.org_z);
+      const Vec3fa dir(ray.dir_x,ray.dir_y,ray.dir_z);
+      const Vec3fa v = org-spheres->centers[primID];
+      const float A = dot(dir,dir);
+      const float B = 2.0f*dot(v,dir);
+      const float C = dot(v,v)-sqr(spheres->radius);
+      const float D = B*B-4.0f*A*C;
+      if (D < 0.0f) return false;
+      const float Q = sqrt(D);
+      const float t0 = 0.5f*(-B-Q)/A;
+      const float t1 = 0.5f*(-B+Q)/A;
+      if (ray.tnear < t0 && t0 <= ray.tfar) { t = t0; return true; }
+      if (ray.tnear < t1 && t1 <= ray.tfar) { t = t1; return true; }
+      return false;
+    }
+
+    /* intersects all primitives passed to the callback */
+    static void intersectFunc(const RTCIntersectFunctionNArguments* args)
+    {
+      if (!args->valid[0]) return;
+      Spheres* spheres = (Spheres*) args->geometryUserPtr;
+      spheres->maxPrimCount = max(spheres->maxPrimCount,args->primCount);
+      RTCRayHit* rayhit = (RTCRayHit*) args->rayhit;
+      for (unsigned int i=0; i<args->primCount; i++)
+      {
+        float t;
+        const unsigned int primID = args->primIDs[i];
+        if (!intersectSphere(spheres,primID,rayhit->ray,t)) continue;
+        rayhit->ray.tfar = t;
+        rayhit->hit.u = rayhit->hit.v = 0.0f;
+        rayhit->hit.Ng_x = rayhit->hit.Ng_y = 0.0f; rayhit->hit.Ng_z = 1.0f;
+        rayhit->hit.primID = primID;
+        rayhit->hit.geomID = args->geomID;
+        rayhit->hit.instID[0] = args->context->instID[0];
+      }
+    }
+
+    static void occludedFunc(const RTCOccludedFunctionNArguments* args)
+    {
+      if (!args->valid[0]) return;
+      Spheres* spheres = (Spheres*) args->geometryUserPtr;
+      spheres->maxPrimCount = max(spheres->maxPrimCount,args->primCount);
+      RTCRay* ray = (RTCRay*) args->ray;
+      for (unsigned int i=0; i<args->primCount; i++)
+      {
+        float t;
+        if (!intersectSphere(spheres,args->primIDs[i],*ray,t)) continue;
+        ray->tfar = neg_inf;
+        return;
+      }
+    }
+
+    void addSpheres(RTCDevice device, RTCScene scene, Spheres& spheres, bool batched)
+    {
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_USER);
+      rtcSetGeometryUserPrimitiveCount(geom,(unsigned int)spheres.centers.size());
+      rtcSetGeometryUserData(geom,&spheres);
+      rtcSetGeometryBoundsFunction(geom,boundsFunc,nullptr);
+      rtcSetGeometryIntersectFunction(geom,intersectFunc);
+      rtcSetGeometryOccludedFunction(geom,occludedFunc);
+      rtcSetGeometryEnableBatchedCallbacks(geom,batched);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* larger leaves let the BVH gather several primitives per callback */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",object_accel_min_leaf_size=4,object_accel_max_leaf_size=8";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      Spheres spheres0, spheres1;
+      spheres0.radius = spheres1.radius = 0.2f;
+      spheres0.maxPrimCount = spheres1.maxPrimCount = 0;
+      for (size_t i=0; i<1000; i++)
+        spheres0.centers.push_back(4.0f*RandomSampler_get3D(sampler));
+      spheres1.centers = spheres0.centers;
+
+      VerifyScene scene0(device,sflags);
+      VerifyScene scene1(device,sflags);
+      addSpheres(device,scene0,spheres0,false);
+      addSpheres(device,scene1,spheres1,true);
+      rtcCommitScene (scene0);
+      rtcCommitScene (scene1);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t i=0; i<1000 && passed; i++)
+      {
+        const Vec3fa org = Vec3fa(2.0f)+8.0f*normalize(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+        const Vec3fa dir = 4.0f*RandomSampler_get3D(sampler)-org;
+        RTCRayHit ray0 = makeRay(org,dir); rtcIntersect1(scene0,&ray0);
+        RTCRayHit ray1 = makeRay(org,dir); rtcIntersect1(scene1,&ray1);
+        passed &= ray0.hit.geomID == ray1.hit.geomID;
+        passed &= ray0.hit.primID == ray1.hit.primID;
+        passed &= ray0.ray.tfar == ray1.ray.tfar;
+
+        RTCRayHit shadow0 = makeRay(org,dir); rtcOccluded1(scene0,&shadow0.ray);
+        RTCRayHit shadow1 = makeRay(org,dir); rtcOccluded1(scene1,&shadow1.ray);
+        passed &= (shadow0.ray.tfar < 0.0f) == (shadow1.ray.tfar < 0.0f);
+        passed &= (shadow0.ray.tfar < 0.0f) == (ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID);
+      }
+      AssertNoError(device);
+
+      /* geometries without batched callbacks get invoked once per primitive */
+      passed &= spheres0.maxPrimCount == 1;
+      passed &= spheres1.maxPrimCount > 1;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   struct EnableDisableGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -5267,14 +5815,15 @@ namespace embree
   {
     thread_func func;
     float intensity;
+    std::string cfg_extra;
     std::vector<IntersectMode> intersectModes;
     
-    MemoryMonitorTest (std::string name, int isa, thread_func func, float intensity)
-      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), func(func), intensity(intensity) {}
+    MemoryMonitorTest (std::string name, int isa, thread_func func, float intensity, std::string cfg_extra = "")
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), func(func), intensity(intensity), cfg_extra(cfg_extra) {}
     
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
-      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + cfg_extra;
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
       
@@ -5594,6 +6143,216 @@ namespace embree
     }
   };
 
+  struct TaskingFunctionsTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    /* minimal job system that runs outermost loops on a few threads and nested loops serially */
+    static const unsigned int numThreads = 4;
+    static thread_local unsigned int threadIndex;
+    static thread_local unsigned int depth;
+    static std::atomic<size_t> numTasks;
+
+    TaskingFunctionsTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    static void runTasks(size_t begin, size_t end, size_t blockSize, RTCTaskFunction task, void* taskPtr)
+    {
+      depth++;
+      for (size_t i=begin; i<end; i+=blockSize) {
+        task(taskPtr,i,min(i+blockSize,end));
+        numTasks++;
+      }
+      depth--;
+    }
+
+    static void parallelFor(void* userPtr, size_t begin, size_t end, size_t blockSize, RTCTaskFunction task, void* taskPtr)
+    {
+      if (depth > 0)
+        return runTasks(begin,end,blockSize,task,taskPtr);
+
+      std::vector<std::thread> threads;
+      for (unsigned int t=1; t<numThreads; t++)
+      {
+        const size_t t0 = begin+(t+0)*(end-begin)/numThreads;
+        const size_t t1 = begin+(t+1)*(end-begin)/numThreads;
+        threads.push_back(std::thread([=] () { threadIndex = t; runTasks(t0,t1,blockSize,task,taskPtr); }));
+      }
+      runTasks(begin,begin+(end-begin)/numThreads,blockSize,task,taskPtr);
+      for (auto& thread : threads) thread.join();
+    }
+
+    static unsigned int getThreadIndex(void* userPtr) { return threadIndex; }
+    static unsigned int getThreadCount(void* userPtr) { return numThreads; }
+
+    void addGeometries(VerifyScene& scene)
+    {
+      const Vec3fa center = zero;
+      const float radius = 1.0f;
+      const Vec3fa dx(1,0,0);
+      const Vec3fa dy(0,1,0);
+      scene.addGeometry(quality,SceneGraph::createTriangleSphere(center,radius,50));
+      scene.addGeometry(quality,SceneGraph::createQuadSphere(center+dx,radius,50));
+      scene.addGeometry(quality,SceneGraph::createGridSphere(center-dx,radius,50));
+      scene.addGeometry(quality,SceneGraph::createSubdivSphere(center+dy,radius,8,20));
+      scene.addGeometry(quality,SceneGraph::createHairyPlane(1,center-dy,dx,dy,0.1f,0.01f,100,SceneGraph::FLAT_CURVE));
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* incomplete tasking functions are rejected */
+      RTCTaskingFunctions functions;
+      functions.parallelFor = parallelFor;
+      functions.threadIndex = nullptr;
+      functions.threadCount = getThreadCount;
+      functions.userPtr = nullptr;
+      rtcSetDeviceTaskingFunctions(device,&functions);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+
+      /* build reference scene with the internal tasking system */
+      VerifyScene scene0(device,sflags);
+      addGeometries(scene0);
+      rtcCommitScene (scene0);
+      AssertNoError(device);
+
+      /* build the same scene as jobs of the external tasking system */
+      numTasks = 0;
+      functions.threadIndex = getThreadIndex;
+      rtcSetDeviceTaskingFunctions(device,&functions);
+      VerifyScene scene1(device,sflags);
+      addGeometries(scene1);
+      rtcCommitScene (scene1);
+      rtcSetDeviceTaskingFunctions(device,nullptr);
+      AssertNoError(device);
+
+      bool passed = numTasks > 0;
+      for (size_t i=0; i<1000 && passed; i++)
+      {
+        const Vec3fa org = 8.0f*normalize(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+        const Vec3fa dir = 2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f)-org;
+        RTCRayHit ray0 = makeRay(org,dir); rtcIntersect1(scene0,&ray0);
+        RTCRayHit ray1 = makeRay(org,dir); rtcIntersect1(scene1,&ray1);
+        passed &= ray0.hit.geomID == ray1.hit.geomID;
+        passed &= ray0.hit.primID == ray1.hit.primID;
+        passed &= ray0.ray.tfar == ray1.ray.tfar;
+      }
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  thread_local unsigned int TaskingFunctionsTest::threadIndex = 0;
+  thread_local unsigned int TaskingFunctionsTest::depth = 0;
+  std::atomic<size_t> TaskingFunctionsTest::numTasks(0);
+
+  struct BuildPriorityTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    BuildPriorityTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene background(device,sflags);
+      VerifyScene foreground(device,sflags);
+      rtcSetSceneBuildPriority(background,RTCBuildPriority(3));
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+
+      /* large background build limited to a single thread and small high priority build */
+      for (size_t i=0; i<8; i++)
+        background.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(float(i),0,0),0.5f,200));
+      foreground.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(0,4,0),0.5f,20));
+      rtcSetSceneBuildThreadCount(background,1);
+      rtcSetSceneBuildPriority(background,RTC_BUILD_PRIORITY_LOW);
+      rtcSetSceneBuildPriority(foreground,RTC_BUILD_PRIORITY_HIGH);
+      AssertNoError(device);
+
+      std::thread thread([&] () { rtcCommitScene(background); });
+      rtcCommitScene(foreground);
+      thread.join();
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t i=0; i<8; i++) {
+        RTCRayHit ray = makeRay(Vec3fa(float(i),0,-2),Vec3fa(0,0,1));
+        rtcIntersect1(background,&ray);
+        passed &= ray.hit.geomID == i;
+      }
+      RTCRayHit ray = makeRay(Vec3fa(0,4,-2),Vec3fa(0,0,1));
+      rtcIntersect1(foreground,&ray);
+      passed &= ray.hit.geomID == 0;
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct CommitScenesTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    CommitScenesTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* many small and one large bottom level scene instanced by a top level scene */
+      const size_t N = 32;
+      std::vector<Ref<VerifyScene>> blas;
+      for (size_t i=0; i<N; i++) {
+        blas.push_back(new VerifyScene(device,sflags));
+        blas[i]->addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(0,0,0),0.5f,i == 0 ? 200 : 2+i));
+      }
+      VerifyScene tlas(device,sflags);
+      for (size_t i=0; i<N; i++)
+      {
+        RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(geom,*blas[i]);
+        const float xfm[12] = { 1,0,0, 0,1,0, 0,0,1, 2.0f*float(i),0,0 };
+        rtcSetGeometryTransform(geom,0,RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR,xfm);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometryByID(tlas,geom,(unsigned int)i);
+        rtcReleaseGeometry(geom);
+      }
+      AssertNoError(device);
+
+      /* pass top level scene first and some scenes twice */
+      std::vector<RTCScene> scenes;
+      scenes.push_back(tlas);
+      for (size_t i=0; i<N; i++) scenes.push_back(*blas[(7*i)%N]);
+      scenes.push_back(*blas[0]);
+      rtcCommitScenes(scenes.data(),scenes.size());
+      AssertNoError(device);
+
+      bool passed = true;
+      RTCBounds bounds;
+      for (size_t i=0; i<N; i++) {
+        rtcGetSceneBounds(*blas[i],&bounds);
+        AssertNoError(device);
+      }
+      for (size_t i=0; i<N; i++) {
+        RTCRayHit ray = makeRay(Vec3fa(2.0f*float(i),0,-2),Vec3fa(0,0,1));
+        rtcIntersect1(tlas,&ray);
+        passed &= ray.hit.instID[0] == i && ray.hit.geomID == 0;
+      }
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
@@ -6248,6 +7007,48 @@ namespace embree
         groups.top()->add(new OverlappingGeometryTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,clamp(int(intensity*10000),1000,100000)));
       groups.pop();
 
+      push(new TestGroup("mixed_accel",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new MixedAccelTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("multi_hit",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new MultiHitTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      /* spatial splits of high quality builds let rays hit the same primitive multiple times */
+      push(new TestGroup("transmittance",true,true));
+      for (auto sflags : sceneFlags)
+        if (sflags.qflags != RTC_BUILD_QUALITY_HIGH)
+          groups.top()->add(new TransmittanceTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("compressed_vertices",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new CompressedVerticesTest(to_string(sflags)+".triangles.half",isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,RTC_FORMAT_HALF3,RTC_FORMAT_UINT3));
+        groups.top()->add(new CompressedVerticesTest(to_string(sflags)+".triangles.short",isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,RTC_FORMAT_SHORT3,RTC_FORMAT_UINT3));
+        groups.top()->add(new CompressedVerticesTest(to_string(sflags)+".quads.half",isa,sflags,RTC_GEOMETRY_TYPE_QUAD,RTC_FORMAT_HALF3,RTC_FORMAT_UINT4));
+        groups.top()->add(new CompressedVerticesTest(to_string(sflags)+".quads.short",isa,sflags,RTC_GEOMETRY_TYPE_QUAD,RTC_FORMAT_SHORT3,RTC_FORMAT_UINT4));
+      }
+      groups.pop();
+
+      push(new TestGroup("compressed_indices",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new CompressedVerticesTest(to_string(sflags)+".triangles",isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,RTC_FORMAT_FLOAT3,RTC_FORMAT_USHORT3));
+        groups.top()->add(new CompressedVerticesTest(to_string(sflags)+".quads",isa,sflags,RTC_GEOMETRY_TYPE_QUAD,RTC_FORMAT_FLOAT3,RTC_FORMAT_USHORT4));
+        groups.top()->add(new CompressedVerticesTest(to_string(sflags)+".triangles.half",isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,RTC_FORMAT_HALF3,RTC_FORMAT_USHORT3));
+        groups.top()->add(new CompressedVerticesTest(to_string(sflags)+".quads.short",isa,sflags,RTC_GEOMETRY_TYPE_QUAD,RTC_FORMAT_SHORT3,RTC_FORMAT_USHORT4));
+      }
+      groups.pop();
+
+      push(new TestGroup("refit_range",true,true));
+      for (auto sflags : sceneFlagsDynamic) {
+        groups.top()->add(new RefitRangeTest(to_string(sflags)+".triangles",isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE));
+        groups.top()->add(new RefitRangeTest(to_string(sflags)+".quads",isa,sflags,RTC_GEOMETRY_TYPE_QUAD));
+      }
+      groups.pop();
+
       push(new TestGroup("new_delete_geometry",true,true));
       for (auto sflags : sceneFlagsDynamic) 
         groups.top()->add(new NewDeleteGeometryTest(to_string(sflags),isa,sflags));
@@ -6258,6 +7059,11 @@ namespace embree
         groups.top()->add(new UserGeometryIDTest(to_string(sflags),isa,sflags));
       groups.pop();
       
+      push(new TestGroup("batched_callbacks",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new BatchedCallbacksTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
       push(new TestGroup("enable_disable_geometry",true,true));
       for (auto sflags : sceneFlagsDynamic) 
         groups.top()->add(new EnableDisableGeometryTest(to_string(sflags),isa,sflags));
@@ -6584,6 +7390,7 @@ namespace embree
 
       groups.top()->add(new MemoryMonitorTest("regression_static_memory_monitor", isa,rtcore_regression_static_thread,30));
       groups.top()->add(new MemoryMonitorTest("regression_dynamic_memory_monitor",isa,rtcore_regression_dynamic_thread,30));
+      groups.top()->add(new MemoryMonitorTest("regression_dynamic_memory_monitor_alloc_pool",isa,rtcore_regression_dynamic_thread,30,",alloc_pool_size=64"));
 
       groups.top()->add(new ParallelForExceptionTest1("parallel_for_exception_test1",isa));
       groups.top()->add(new ParallelForExceptionTest2("parallel_for_exception_test2",isa));
@@ -6593,6 +7400,11 @@ namespace embree
       groups.top()->add(new ParallelForExceptionTest6("parallel_for_exception_test6",isa));
       groups.top()->add(new ParallelForExceptionTest7("parallel_for_exception_test7",isa));
 
+      groups.top()->add(new TaskingFunctionsTest("tasking_functions_high",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_HIGH),RTC_BUILD_QUALITY_HIGH));
+      groups.top()->add(new TaskingFunctionsTest("tasking_functions_low",isa,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_LOW));
+      groups.top()->add(new BuildPriorityTest("build_priority",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM)));
+      groups.top()->add(new CommitScenesTest("commit_scenes",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM)));
+
       /**************************************************************************/
       /*                  Function Level Testing                                */
       /**************************************************************************/